@@ -0,0 +1,100 @@
+#include "big_font.h"
+
+/////////////////////////////////////////
+
+constexpr uint8_t BIG_CELL_W  = 10;    // Bytes pro Seite und Glyphe
+constexpr uint8_t BIG_SPACING = 2;     // Leerspalten nach jeder Glyphe
+
+// Reihenfolge: 0-9, '-', '.', ' ', Grad
+const uint8_t big_font[][BIG_CELL_W * BIG_FONT_HEIGHT_PAGES] PROGMEM = {
+  { 0xFC, 0xFE, 0x07, 0x03, 0x03, 0x03, 0x03, 0x07, 0xFE, 0xFC, 0x1F, 0x3F, 0x70, 0x60, 0x60, 0x60, 0x60, 0x70, 0x3F, 0x1F },  // '0'
+  { 0x00, 0x08, 0x0C, 0x06, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x7F, 0x7F, 0x60, 0x60, 0x60, 0x00 },  // '1'
+  { 0x0C, 0x0E, 0x07, 0x03, 0x83, 0x83, 0xC3, 0xE7, 0x7E, 0x3C, 0x78, 0x7C, 0x6E, 0x67, 0x63, 0x61, 0x60, 0x60, 0x60, 0x60 },  // '2'
+  { 0x04, 0x06, 0x07, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x3E, 0x3C, 0x10, 0x30, 0x70, 0x60, 0x60, 0x60, 0x60, 0x71, 0x3F, 0x1F },  // '3'
+  { 0xC0, 0xE0, 0x30, 0x18, 0x0C, 0x06, 0x03, 0xFF, 0xFF, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x7F, 0x7F, 0x03 },  // '4'
+  { 0x7F, 0x7F, 0x63, 0x63, 0x63, 0x63, 0x63, 0xE3, 0xC3, 0x83, 0x10, 0x30, 0x70, 0x60, 0x60, 0x60, 0x60, 0x70, 0x3F, 0x1F },  // '5'
+  { 0xF8, 0xFC, 0xCE, 0x67, 0x63, 0x63, 0x63, 0xE3, 0xC3, 0x80, 0x1F, 0x3F, 0x70, 0x60, 0x60, 0x60, 0x60, 0x70, 0x3F, 0x1F },  // '6'
+  { 0x03, 0x03, 0x03, 0x03, 0x03, 0x83, 0xE3, 0xFB, 0x3F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x7F, 0x03, 0x00, 0x00, 0x00 },  // '7'
+  { 0x3C, 0xFE, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0xFE, 0x3C, 0x1F, 0x3F, 0x71, 0x60, 0x60, 0x60, 0x60, 0x71, 0x3F, 0x1F },  // '8'
+  { 0x7C, 0xFE, 0xC7, 0x83, 0x83, 0x83, 0x83, 0xC7, 0xFE, 0xFC, 0x00, 0x60, 0x61, 0x61, 0x61, 0x61, 0x71, 0x38, 0x1F, 0x0F },  // '9'
+  { 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00 },  // '-'
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  // '.'
+  { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  // ' '
+  { 0x0E, 0x1B, 0x11, 0x1B, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  // Grad
+};
+
+const uint8_t big_font_width[] PROGMEM = {
+  10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 2, 10, 6
+};
+
+/////////////////////////////////////////
+
+static int8_t bigGlyphIndex(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  switch (c) {
+    case '-':        return 10;
+    case '.':        return 11;
+    case ' ':        return 12;
+    case BIG_DEGREE: return 13;
+  }
+  return -1;
+}
+
+uint8_t bigTextWidth(const char* text) {
+  uint8_t w = 0;
+  for (; *text; ++text) {
+    int8_t idx = bigGlyphIndex(*text);
+    if (idx < 0) continue;
+    w += pgm_read_byte(&big_font_width[idx]) + BIG_SPACING;
+  }
+  return w;
+}
+
+uint8_t drawBigText(Adafruit_SSD1306& dis, uint8_t x, uint8_t page, const char* text) {
+  if (page + BIG_FONT_HEIGHT_PAGES > SCREEN_HEIGHT / 8) return x;
+  uint8_t* buf = dis.getBuffer();
+
+  for (; *text && x < SCREEN_WIDTH; ++text) {
+    int8_t idx = bigGlyphIndex(*text);
+    if (idx < 0) continue;
+    uint8_t w = pgm_read_byte(&big_font_width[idx]);
+    uint8_t n = (x + w > SCREEN_WIDTH) ? SCREEN_WIDTH - x : w;
+    uint8_t gap = (x + n + BIG_SPACING > SCREEN_WIDTH) ? SCREEN_WIDTH - x - n : BIG_SPACING;
+
+    for (uint8_t p = 0; p < BIG_FONT_HEIGHT_PAGES; ++p) {
+      uint8_t* dst = buf + (page + p) * SCREEN_WIDTH + x;
+      memcpy_P(dst, &big_font[idx][p * BIG_CELL_W], n);
+      memset(dst + n, 0, gap);
+    }
+    x += n + gap;
+  }
+  return x;
+}
+
+uint8_t drawBigValue(Adafruit_SSD1306& dis, uint8_t x_right, uint8_t page, float value, uint8_t decimals, char suffix) {
+  // Festkomma-Formatierung ohne dtostrf/float-Print
+  char text[12];
+  uint8_t pos = sizeof(text) - 1;
+  text[pos] = '\0';
+  if (suffix) text[--pos] = suffix;
+
+  float scale = 1;
+  for (uint8_t i = 0; i < decimals; ++i) scale *= 10;
+  int32_t v = lroundf(value * scale);
+  bool negative = v < 0;
+  if (negative) v = -v;
+
+  uint8_t digits = 0;
+  do {
+    if (digits == decimals && decimals > 0) text[--pos] = '.';
+    text[--pos] = '0' + (v % 10);
+    v /= 10;
+    digits++;
+  } while ((v > 0 || digits <= decimals) && pos > 1);
+  if (negative) text[--pos] = '-';
+
+  uint8_t w = bigTextWidth(&text[pos]);
+  uint8_t x = (w > x_right) ? 0 : x_right - w;
+  drawBigText(dis, x, page, &text[pos]);
+  return x;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "testfile.h"
+
+/*********************************************
+Große Ziffern (10x16) für Navigations-Screens
+
+Die Glyphen liegen in PROGMEM bereits im SSD1306-Seitenformat
+(1 Byte = 8 Pixel senkrecht). Gezeichnet wird per memcpy_P direkt
+in den Framebuffer, ohne Adafruit_GFX-Pixelweg. y ist deshalb eine
+Seite (0..7), nicht ein Pixel.
+*********************************************/
+
+constexpr uint8_t BIG_FONT_HEIGHT_PAGES = 2;
+constexpr char    BIG_DEGREE = '\x7f';     // Gradzeichen im Text
+
+uint8_t bigTextWidth(const char* text);
+uint8_t drawBigText(Adafruit_SSD1306& dis, uint8_t x, uint8_t page, const char* text);
+
+// Zahl mit festen Nachkommastellen rechtsbündig bis x_right, optional mit Suffix
+// (z.B. BIG_DEGREE). Gibt die linke x-Position zurück.
+uint8_t drawBigValue(Adafruit_SSD1306& dis, uint8_t x_right, uint8_t page, float value, uint8_t decimals, char suffix = 0);
@@ -1,4 +1,5 @@
 #include "testfile.h"
+#include "trend_graph.h"
 
 Adafruit_BME280     bme; // I2C
 RTC_DS3231          rtc;
@@ -8,31 +9,61 @@ MPU9250_WE imu =    MPU9250_WE(MPU9250_ADDR);
 void setup() {
   Serial.begin(9600);
   systemInit(bme, rtc, display, imu);
-  renderDisplay_Setup(display, 1);
+  trendBegin();
+  if (deviceOk(DEV_DISPLAY)) {
+    renderDisplay_Setup(display, 1);
+    redraw_pending = false;
+  }
 }
 
 
 void loop() {
-  DateTime right_now = rtc.now();
+  // beim Booten fehlende Geräte im Hintergrund nachholen
+  systemInitRetry(bme, rtc, display, imu);
+  bool display_ok = deviceOk(DEV_DISPLAY);
+  bool bme_ok = deviceOk(DEV_BME);
+  bool imu_ok = deviceOk(DEV_IMU);
+  bool rtc_ok = deviceOk(DEV_RTC);
+
+  DateTime right_now = rtcNow(rtc);
   //renderDisplay_everyLoop(display);
-  BMEData current_bme;
-  IMUData current_imu;
-  
+  // static: zwischen den Messungen bleiben die letzten Werte für renderDisplay() gültig
+  static BMEData current_bme;
+  static IMUData current_imu;
 
+  // Taster in jeder Loop-Runde abfragen (nicht nur im 300-ms-Takt).
+  // Ein Screenwechsel wird sofort und vor allem anderen gezeichnet.
+  // Neuer Druck zählt nur, wenn vorher button_debounce_time lang nichts gedrückt
+  // war (Prellen beim Loslassen löst so keinen zweiten Druck aus).
+  uint8_t button_now = updateButtons();
+  if (button_now != 0) {
+    if (buttoninput == 0 && millis() - button_seen_time > button_debounce_time) {
+      latencyProbeStart();
+      updateMenuSystem(button_now);
+    }
+    button_seen_time = millis();
+  }
+  buttoninput = button_now;
+
+  if (redraw_pending && display_ok) {
+    renderDisplay(display, current_bme, current_imu, right_now, current_display);
+    redraw_pending = false;
+    latencyProbeStop();
+  }
 
   if (millis() - globaltimer > delaytime_for_loop) {
-    buttoninput = updateButtons();
     if (counter_for_measurment_within_loop % 2 == 1){
-      current_bme = updateSensors(bme);
+      if (bme_ok) current_bme = updateSensors(bme);
       counter_for_measurment_within_loop = 0;
     } else {
       counter_for_measurment_within_loop++;
     }
     
-    current_imu = updateNavigation(imu);
-    mag_geglaettet = get_mag_mittelwert(current_imu.heading);
-    current_imu.heading = mag_geglaettet;
-    updateMenuSystem(buttoninput);
+    if (imu_ok) {
+      current_imu = updateNavigation(imu);
+      mag_geglaettet = get_mag_mittelwert(current_imu.heading);
+      current_imu.heading = mag_geglaettet;
+    }
     /*
     Serial.print("buttoninput\t");
     Serial.println(buttoninput);
@@ -42,28 +73,27 @@ void loop() {
      */
 
     
-    if (right_now.minute() != old_minute) {
+    // ohne BME keine Mittelwerte/Verlauf (sonst Nullen im 24-h-Graph)
+    if (bme_ok && right_now.minute() != old_minute) {
       mittelw_bme = get_mittelwert(current_bme);
       old_minute = right_now.minute();
     }
+    // ohne RTC keine echte Stunde: nichts in den 24-h-Verlauf einsortieren
     uint8_t right_now_hour = right_now.hour();
-    if (right_now_hour != old_hour) {
+    if (bme_ok && rtc_ok && right_now_hour != old_hour) {
       if (old_hour == 99) {
-        temp_messungen[right_now_hour] = mittelw_bme.temp;
-        humid_messungen[right_now_hour] = mittelw_bme.humi;
-        baro_messungen[right_now_hour] = mittelw_bme.baro;
-        
+        trendStoreBucket(right_now_hour, mittelw_bme);
       } else {
         uint8_t index_minus_one_hour = (right_now_hour + 24 - 1) % 24;
-        temp_messungen[index_minus_one_hour] = mittelw_bme.temp;
-        humid_messungen[index_minus_one_hour] = mittelw_bme.humi;
-        baro_messungen[index_minus_one_hour] = mittelw_bme.baro;
+        trendStoreBucket(index_minus_one_hour, mittelw_bme);
       }
       
       old_hour = right_now.hour();
     }
 
-    renderDisplay(display, current_bme, current_imu, right_now, current_display);
+    // Lage/Kompass zeichnet mit IMU der schnelle Takt unten (eigener Kurs-EMA)
+    bool fast_owned = (current_display == 4 || current_display == 5) && imu_ok;
+    if (display_ok && !fast_owned) renderDisplay(display, current_bme, current_imu, right_now, current_display);
 
 
 #if DEBUG
@@ -84,6 +114,21 @@ void loop() {
     globaltimer = millis();
   }
   
+  // Lage- und Kompass-Screen: eigener, schnellerer Takt nur für Lage + Zeichnen,
+  // Buttons und BME bleiben im normalen Loop-Takt.
+  bool fast_screen = (current_display == 4 || current_display == 5);
+  if (fast_screen && display_ok && imu_ok && millis() - compasstimer > delaytime_for_compass) {
+    // Roll/Pitch frisch, Kurs über einen eigenen kurzen EMA: der Mittelwert
+    // mag_geglaettet wird nur im normalen Takt gefüttert (300 ms)
+    IMUData compass_imu = updateNavigation(imu);
+    compass_imu.heading = get_kurs_schnell(compass_imu.heading);
+    // Kompassrose nur neu zeichnen, wenn sich der Kurs in ganzen Grad ändert
+    if (current_display == 4 || kursGerundet(compass_imu.heading) != kurs_gezeichnet) {
+      renderDisplay(display, current_bme, compass_imu, right_now, current_display);
+    }
+    compasstimer = millis();
+  }
+
   handleAlarms();
 /*
   Serial.print("8\t");
@@ -11,16 +11,21 @@
 #include <Adafruit_SSD1306.h>
 #include <MPU9250_WE.h>
 
+#include "trig_lut.h"
+#include "trend_graph.h"
+#include "big_font.h"
+
 /////////////////////////////////////////
 
 
 #define initialize_delay 20
 #define initialize_fail_delay 1000
 
-#define booting_display_message_delay 300
 
 uint16_t delaytime_for_loop = 300;
 unsigned long globaltimer = 0;
+uint16_t delaytime_for_compass = 100;
+unsigned long compasstimer = 0;
 uint8_t counter_for_measurment_within_loop = 0;
 
 uint8_t old_hour = 99;
@@ -28,11 +33,45 @@ uint8_t old_minute = 99;
 uint8_t mittelwert_divisor = 0;
 
 uint8_t buttoninput = 1;
+unsigned long button_seen_time = 0;
+uint16_t button_debounce_time = 50;
+bool redraw_pending = false;
+
+unsigned long latency_start_us = 0;
+bool latency_armed = false;
+unsigned long latency_last_us = 0;
+unsigned long latency_max_us = 0;
+
+// Flanke des Tastendrucks, im Timer0-Compare-ISR erfasst (~1 kHz), damit
+// die Latenz auch die Zeit bis zur nächsten Abfrage in loop() enthält
+volatile unsigned long button_edge_us = 0;
+volatile unsigned long button_released_ms = 0;
+volatile bool button_was_down = false;
+
+// Gestufter Start: was beim Booten nicht antwortet, wird in loop() im
+// Hintergrund nachversucht (ein Gerät pro initialize_fail_delay)
+uint8_t devices_ok = 0;
+uint8_t device_retry_next = 0;
+unsigned long device_retry_timer = 0;
+// Acc-/Gyro-Offsets aus autoOffsets() beim Booten; ein später gefundener
+// IMU bekommt diese (autoOffsets() blockiert über eine Sekunde)
+xyzFloat imu_acc_offsets = { 0, 0, 0 };
+xyzFloat imu_gyr_offsets = { 0, 0, 0 };
+bool imu_offsets_ok = false;
+unsigned long boot_first_frame_ms = 0;
 uint8_t current_display = 0;
-uint8_t max_number_of_displays = 8;
+uint8_t max_number_of_displays = 9;
+uint8_t last_rendered_display = 99;
 
 uint8_t moon_position_offset_x = 0;
 bool moon_going_right = 1;
+
+// Software-Uhr über den 1-Hz-SQW-Ausgang des DS3231 (statt rtc.now() in jeder Loop)
+volatile uint32_t rtc_sqw_ticks = 0;
+volatile unsigned long rtc_sqw_edge_ms = 0;
+uint32_t rtc_base_epoch = 0;
+unsigned long rtc_last_sync = 0;
+unsigned long rtc_resync_interval = 3600000UL;   // 1 h
 /////////////////////////////////////////
 
 BMEData hourly_summe_bme;
@@ -68,6 +107,8 @@ float  mittelwert_magnetkurse[mag_mittelwerte] = {
 
 uint8_t mag_mittelwert_index = 0;
 uint16_t mag_geglaettet = 0;
+float kurs_schnell = -1;           // geglätteter Kurs für den schnellen Kompass-Takt
+int16_t kurs_gezeichnet = -1;      // zuletzt auf Screen 5 gezeichneter Kurs
 
 /////////////////////////////////////////
 
@@ -84,59 +125,110 @@ void systemInit(Adafruit_BME280& bme_var, RTC_DS3231& rtc_var, Adafruit_SSD1306&
   /////WIRE
   Wire.begin();
   Wire.setClock(400000);
+#if defined(WIRE_HAS_TIMEOUT)
+  // hängender Bus (z. B. Sensor halb abgesteckt) darf loop() nicht anhalten
+  Wire.setWireTimeout(25000, true);
+#endif
   delay(initialize_delay);
-  /////BME
-  while (!initBME280(bme_var)) {
+
+  /////TASTERPINS
+  for (int i = 8; i <= 12; ++i) {
+    pinMode(i, INPUT_PULLUP);
+  }
+  buttonEdgeBegin();
 #if DEBUG
-    Serial.println("BME-Sensor nicht gefunden");
+  Serial.println(F("Tasterpins initialisiert!"));
 #endif
-    delay(initialize_fail_delay);
+
+  /////GERAETE: jedes genau einmal versuchen, fehlende holt systemInitRetry() nach
+  const uint8_t order[] = { DEV_DISPLAY, DEV_BME, DEV_RTC, DEV_IMU };
+  for (uint8_t i = 0; i < sizeof(order); ++i) {
+    if (tryInitDevice(order[i], true, bme_var, rtc_var, display_var, imu_var)) {
+      devices_ok |= order[i];
+    }
+  }
+  device_retry_timer = millis();
+  redraw_pending = true;
+}
+
+// Ein fehlendes Gerät pro Aufruf, reihum, höchstens alle initialize_fail_delay.
+// Jede loop()-Runde aufrufen; kostet nichts, solange alles läuft.
+void systemInitRetry(Adafruit_BME280& bme_var, RTC_DS3231& rtc_var, Adafruit_SSD1306& display_var, MPU9250_WE& imu_var) {
+  if (devices_ok == DEV_ALL) return;
+  if (millis() - device_retry_timer < initialize_fail_delay) return;
+  device_retry_timer = millis();
+
+  uint8_t device;
+  do {
+    device = 1 << device_retry_next;
+    device_retry_next = (device_retry_next + 1) % 4;
+  } while (devices_ok & device);
+
+  if (tryInitDevice(device, false, bme_var, rtc_var, display_var, imu_var)) {
+    devices_ok |= device;
+    redraw_pending = true;
+    // bisher lief die Ersatzzeit ab 2000-01-01, die echte Stunde/Minute
+    // springt jetzt: wie nach dem Start neu anfangen
+    if (device == DEV_RTC) {
+      old_hour = 99;
+      old_minute = 99;
+    }
   }
+}
+
+bool tryInitDevice(uint8_t device, bool boot, Adafruit_BME280& bme_var, RTC_DS3231& rtc_var, Adafruit_SSD1306& display_var, MPU9250_WE& imu_var) {
+  switch (device) {
+    case DEV_BME:
+      if (initBME280(bme_var)) {
 #if DEBUG
-  Serial.println("BME-Sensor initialisiert!");
+        Serial.println("BME-Sensor initialisiert!");
 #endif
-  delay(initialize_delay);
-  /////RTC
-  while (!initRTC(rtc_var)) {
+        return true;
+      }
 #if DEBUG
-    Serial.println(F("FEHLER: DS3231-RTC nicht gefunden. Wiring/Adresse prüfen!"));
+      Serial.println("BME-Sensor nicht gefunden");
 #endif
-    delay(initialize_fail_delay);
-  }
+      return false;
+    case DEV_RTC:
+      if (initRTC(rtc_var)) {
+        rtcSqwBegin(rtc_var);
 #if DEBUG
-  Serial.println(F("DS3231-RTC initialisiert!"));
+        Serial.println(F("DS3231-RTC initialisiert!"));
 #endif
-  delay(initialize_delay);
-  /////DISPLAY
-  while (!initDISPLAY(display_var)) {
+        return true;
+      }
 #if DEBUG
-    Serial.println(F("SSD1306-Display nicht gefunden. Check Verkabelung/Adresse!"));
+      Serial.println(F("FEHLER: DS3231-RTC nicht gefunden. Wiring/Adresse prüfen!"));
 #endif
-    delay(initialize_fail_delay);
-  }
-  delay(initialize_delay);
+      return false;
+    case DEV_DISPLAY:
+      if (initDISPLAY(display_var)) {
 #if DEBUG
-  Serial.println(F("SSD1306-Display initialisiert!"));
+        Serial.println(F("SSD1306-Display initialisiert!"));
 #endif
-  /////IMU
-  while (!initIMU(imu_var)) {
+        return true;
+      }
 #if DEBUG
-    Serial.println(F("FEHLER: MPU9250-Sensor antwortet nicht. Verkabelung/Adresse prüfen!"));
+      Serial.println(F("SSD1306-Display nicht gefunden. Check Verkabelung/Adresse!"));
 #endif
-    delay(initialize_fail_delay);
-  }
+      return false;
+    case DEV_IMU:
+      if (initIMU(imu_var, boot)) {
 #if DEBUG
-  Serial.println(F("MPU9250-Sensor initialisiert!"));
+        Serial.println(F("MPU9250-Sensor initialisiert!"));
 #endif
-
-  /////TASTERPINS
-  for (int i = 8; i <= 12; ++i) {
-    pinMode(i, INPUT_PULLUP);
-  }
+        return true;
+      }
 #if DEBUG
-  Serial.println(F("Tasterpins initialisiert!"));
+      Serial.println(F("FEHLER: MPU9250-Sensor antwortet nicht. Verkabelung/Adresse prüfen!"));
 #endif
+      return false;
+  }
+  return false;
+}
 
+bool deviceOk(uint8_t device) {
+  return (devices_ok & device) != 0;
 }
 
 /////////////////////////////////////////
@@ -181,7 +273,59 @@ bool initRTC(RTC_DS3231& rtc_var) {
   return false;
 }
 
+// ISR: fallende Flanke am SQW-Pin = Sekundenwechsel im DS3231
+void rtcSqwTick() {
+  rtc_sqw_ticks++;
+  rtc_sqw_edge_ms = millis();
+}
+
+void rtcSqwBegin(RTC_DS3231& rtc_var) {
+  rtc_var.writeSqwPinMode(DS3231_SquareWave1Hz);
+  pinMode(RTC_SQW_PIN, INPUT_PULLUP);      // SQW ist Open-Drain
+  attachInterrupt(digitalPinToInterrupt(RTC_SQW_PIN), rtcSqwTick, FALLING);
+}
+
+// Uhrzeit ohne I2C: Epoch beim letzten Abgleich + gezählte Sekunden.
+// Gelesen wird nur beim ersten Aufruf, nach rtc_resync_interval und
+// solange keine SQW-Flanken kommen (dann wie bisher jedes Mal).
+DateTime rtcNow(RTC_DS3231& rtc_var) {
+  // ohne RTC: Laufzeit ab 1.1.2000, damit Minuten-/Stundenwechsel weiterlaufen
+  if (!deviceOk(DEV_RTC)) {
+    return DateTime(SECONDS_FROM_1970_TO_2000 + millis() / 1000);
+  }
+  noInterrupts();
+  uint32_t ticks = rtc_sqw_ticks;
+  unsigned long edge = rtc_sqw_edge_ms;
+  interrupts();
+
+  bool sqw_running = ticks > 0 && millis() - edge < 2500;
+  if (!sqw_running) {
+    return rtc_var.now();
+  }
+  if (rtc_base_epoch == 0 || millis() - rtc_last_sync > rtc_resync_interval) {
+    uint32_t t = rtc_var.now().unixtime();
+    noInterrupts();
+    uint32_t ticks_after = rtc_sqw_ticks;
+    interrupts();
+    // Flanke während des Lesens: Zuordnung unsicher, beim nächsten Aufruf nochmal
+    if (ticks_after == ticks) {
+      rtc_base_epoch = t - ticks;
+      rtc_last_sync = millis();
+    }
+    return DateTime(t);
+  }
+  return DateTime(rtc_base_epoch + ticks);
+}
+
+// Antwortet an addr jemand? (begin() mancher Libraries prüft das nicht)
+bool i2cAck(uint8_t addr) {
+  Wire.beginTransmission(addr);
+  return Wire.endTransmission() == 0;
+}
+
 bool initDISPLAY(Adafruit_SSD1306& display_var) {
+  // SSD1306::begin() schickt nur Kommandos und meldet immer Erfolg
+  if (!i2cAck(SCREEN_ADDRESS)) return false;
   if (display_var.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS)) {
     display_var.clearDisplay();
     display_var.setTextSize(1);
@@ -192,7 +336,10 @@ bool initDISPLAY(Adafruit_SSD1306& display_var) {
   return false;
 }
 
-bool initIMU(MPU9250_WE& imu_var) {
+// boot = false: Nachversuch aus loop(), dort kein delay() und kein
+// autoOffsets(), sondern die Offsets vom Booten (falls es welche gibt)
+bool initIMU(MPU9250_WE& imu_var, bool boot) {
+  if (!i2cAck(MPU9250_ADDR)) return false;
   if (imu_var.init()) {
     // ---------- Sensorbereiche setzen ----------
     // Acc: +/-2g,4g,8g,16g
@@ -208,9 +355,16 @@ bool initIMU(MPU9250_WE& imu_var) {
     // Mag: Betriebsmodus setzen
     imu_var. setMagOpMode(AK8963_CONT_MODE_100HZ);
 
-    delay(100);
-
-    imu_var.autoOffsets();  // Kalibrieren
+    if (boot) {
+      delay(100);
+      imu_var.autoOffsets();  // Kalibrieren
+      imu_acc_offsets = imu_var.getAccOffsets();
+      imu_gyr_offsets = imu_var.getGyrOffsets();
+      imu_offsets_ok = true;
+    } else if (imu_offsets_ok) {
+      imu_var.setAccOffsets(imu_acc_offsets);
+      imu_var.setGyrOffsets(imu_gyr_offsets);
+    }
     return true;
   }
   return false;
@@ -310,11 +464,75 @@ IMUData updateNavigation(MPU9250_WE& imu_var) {
 //////////////////////////////////
 
 void updateMenuSystem(uint8_t button) {
+  uint8_t old_display = current_display;
   if (button == 1) {
     current_display = (current_display + 1) % max_number_of_displays;
   } else if (button == 2) {
     current_display = (current_display + max_number_of_displays - 1) % max_number_of_displays;
   }
+  // neuer Screen wird in der nächsten Loop-Runde sofort gezeichnet
+  if (current_display != old_display) redraw_pending = true;
+}
+
+//////////////////////////////////
+
+// Latenz-Messung Tastendruck -> Pixel am Display
+// Timer0 läuft ohnehin für millis(); Compare A in der Mitte des Zählers
+// ergibt einen zweiten Interrupt mit ~1 kHz
+void buttonEdgeBegin() {
+  OCR0A = 0x80;
+  TIMSK0 |= _BV(OCIE0A);
+}
+
+// Mega 2560: D8 = PH5, D9 = PH6, D10..D12 = PB4..PB6 (direkt gelesen,
+// digitalRead() wäre für 1 kHz zu teuer). Gleiche Regel wie in loop():
+// ein Druck zählt nur, wenn vorher button_debounce_time lang nichts
+// gedrückt war, Prellen beim Loslassen setzt die Flanke also nicht neu.
+ISR(TIMER0_COMPA_vect) {
+  bool down = (~PINH & (_BV(5) | _BV(6))) || (~PINB & (_BV(4) | _BV(5) | _BV(6)));
+  if (down && !button_was_down && millis() - button_released_ms > button_debounce_time) {
+    button_edge_us = micros();
+  }
+  if (!down && button_was_down) button_released_ms = millis();
+  button_was_down = down;
+}
+
+void latencyProbeStart() {
+  noInterrupts();
+  latency_start_us = button_edge_us;
+  interrupts();
+  latency_armed = true;
+}
+
+void latencyProbeStop() {
+  if (!latency_armed) return;
+  latency_last_us = micros() - latency_start_us;
+  if (latency_last_us > latency_max_us) latency_max_us = latency_last_us;
+  latency_armed = false;
+#if DEBUG
+  Serial.print(F("Latenz Taster->Display [us]\t"));
+  Serial.println(latency_last_us);
+#endif
+}
+
+// Boot-Zeit bis zum ersten fertigen Bild (einmalig)
+void bootFrameProbe() {
+  if (boot_first_frame_ms != 0) return;
+  boot_first_frame_ms = millis();
+#if DEBUG
+  Serial.print(F("Boot->erstes Bild [ms]\t"));
+  Serial.println(boot_first_frame_ms);
+#endif
+}
+
+// fehlende Geräte als "---"
+void printDeviceStatus(Adafruit_SSD1306& dis) {
+  dis.print(deviceOk(DEV_BME) ? F("BME ") : F("--- "));
+  dis.print(deviceOk(DEV_RTC) ? F("RTC ") : F("--- "));
+  dis.print(deviceOk(DEV_DISPLAY) ? F("OLED ") : F("--- "));
+  // IMU* = erst nach dem Booten gefunden, ohne Acc-/Gyro-Offsets
+  if (!deviceOk(DEV_IMU)) dis.println(F("---"));
+  else dis.println(imu_offsets_ok ? F("IMU") : F("IMU*"));
 }
 
 void renderDisplay_Setup(Adafruit_SSD1306& dis, uint8_t mode) {
@@ -328,20 +546,13 @@ void renderDisplay_Setup(Adafruit_SSD1306& dis, uint8_t mode) {
   dis.println(F("2025"));
   dis.println(F(""));
   if (mode == 1) {
-    dis.print(F("booting"));
+    printDeviceStatus(dis);
     dis.display();
-
-
-    for (uint8_t i = 0; i < 3; ++i) {
-      delay(booting_display_message_delay);
-      dis.print(F("."));
-      dis.display();
-    }
   } else {
     dis.print(F("push button to continue..."));
     dis.display();
   }
-
+  bootFrameProbe();
 }
 
 /*
@@ -353,6 +564,16 @@ void renderDisplay_Setup(Adafruit_SSD1306& dis, uint8_t mode) {
 
 
 void renderDisplay(Adafruit_SSD1306& dis, BMEData& bme_struct, IMUData& imu_struct, DateTime dt, uint8_t displaymode) {
+  bool screen_changed = (displaymode != last_rendered_display);
+  last_rendered_display = displaymode;
+
+  //verlauf 24h: zeichnet inkrementell in den bestehenden Framebuffer
+  if (displaymode == 8) {
+    if (trendRender(dis, screen_changed)) dis.display();
+    bootFrameProbe();
+    return;
+  }
+
   dis.clearDisplay();
   dis.setCursor(0, 0);
 
@@ -400,52 +621,35 @@ void renderDisplay(Adafruit_SSD1306& dis, BMEData& bme_struct, IMUData& imu_stru
         break;
       }
     case 3: {
-        dis.setTextSize(2);
-        dis.print(F("T:  "));
-        dis.println(bme_struct.temp, 1);
-        dis.print(F("H:  "));
-        dis.println(bme_struct.humi, 1);
-        dis.print(F("B: "));
-        dis.println(bme_struct.baro, 1);
+        // große Ziffern direkt in den Framebuffer, Zeilen auf Seite 0 / 3 / 6
+        dis.setTextSize(1);
+        dis.setCursor(0, 4);  dis.print(F("T"));
+        dis.setCursor(0, 28); dis.print(F("H"));
+        dis.setCursor(0, 52); dis.print(F("B"));
+        drawBigValue(dis, 108, 0, bme_struct.temp, 1);
+        drawBigValue(dis, 108, 3, bme_struct.humi, 1);
+        drawBigValue(dis, 108, 6, bme_struct.baro, 1);
+        dis.setCursor(110, 8);  dis.print(F("C"));
+        dis.setCursor(110, 32); dis.print(F("%"));
+        dis.setCursor(110, 56); dis.print(F("hPa"));
         dis.display();
         break;
 
       }
     case 4: {
-        dis.setTextSize(2);
-        dis.print(F("R: "));
-        float temp_roll = imu_struct.roll;
-        if (temp_roll >= 0) dis.print(F(" "));
-        if (temp_roll >= 0 && temp_roll < 10) dis.print(F(" "));
-        if (temp_roll < 0 && temp_roll > -10) dis.print(F(" "));
-        dis.println(temp_roll, 1);
-        dis.print(F("P: "));
-        float temp_pitch = imu_struct.pitch;
-        if (temp_pitch >= 0) dis.print(F(" "));
-        if (temp_pitch >= 0 && temp_pitch < 10) dis.print(F(" "));
-        if (temp_pitch < 0 && temp_pitch > -10) dis.print(F(" "));
-        dis.println(temp_pitch, 1);
-        dis.print(F("M: "));
-        float temp_heading = imu_struct.heading;
-        if (temp_heading < 100) dis.print(F("0"));
-        if (temp_heading < 10) dis.print(F("0"));
-        dis.println(imu_struct.heading, 1);
+        dis.setTextSize(1);
+        dis.setCursor(0, 4);  dis.print(F("R"));
+        dis.setCursor(0, 28); dis.print(F("P"));
+        dis.setCursor(0, 52); dis.print(F("M"));
+        drawBigValue(dis, SCREEN_WIDTH, 0, imu_struct.roll, 1, BIG_DEGREE);
+        drawBigValue(dis, SCREEN_WIDTH, 3, imu_struct.pitch, 1, BIG_DEGREE);
+        drawBigValue(dis, SCREEN_WIDTH, 6, imu_struct.heading, 1, BIG_DEGREE);
         dis.display();
         break;
       }
     case 5: {
-        int cx = SCREEN_WIDTH / 2;
-        int cy = SCREEN_HEIGHT / 2;
-        int r  = SCREEN_HEIGHT / 3;
-        int x, y;
-        float needle_angle = -imu_struct.heading;       // Gegenrichtung
-        if (needle_angle < 0) needle_angle += 360.0;
-        dis.drawCircle(cx, cy, r, SSD1306_WHITE);
-        pointOnCircle(cx, cy, r, needle_angle, x, y);
-        dis.drawLine(cx, cy, x, y, SSD1306_WHITE);
-
-        //dis.drawLine(SCREEN_WIDTH/2, SCREEN_HEIGHT/2, (int)imu_struct.heading/10, 5, SSD1306_WHITE);
-        //dis.drawPixel(imu_struct.heading,1);
+        kurs_gezeichnet = kursGerundet(imu_struct.heading);
+        renderCompassRose(dis, kurs_gezeichnet);
         dis.display();
         break;
       }
@@ -453,6 +657,12 @@ void renderDisplay(Adafruit_SSD1306& dis, BMEData& bme_struct, IMUData& imu_stru
     case 6: {
         dis.setTextSize(1);
         dis.println(F("Settings:"));
+        dis.println();
+        dis.println(F("Latenz Taster->Pixel"));
+        dis.print(F("letzte: ")); dis.print(latency_last_us / 1000.0, 1); dis.println(F(" ms"));
+        dis.print(F("max:    ")); dis.print(latency_max_us / 1000.0, 1); dis.println(F(" ms"));
+        dis.print(F("Boot->Bild: ")); dis.print(boot_first_frame_ms); dis.println(F(" ms"));
+        printDeviceStatus(dis);
         dis.display();
         break;
     }
@@ -495,6 +705,7 @@ void renderDisplay(Adafruit_SSD1306& dis, BMEData& bme_struct, IMUData& imu_stru
       
     }
   }
+  bootFrameProbe();
 }
 
 float get_mag_mittelwert(float cur_head) {
@@ -514,6 +725,27 @@ float get_mag_mittelwert(float cur_head) {
   return result / divisor_counter;
 }
 
+// Kurzer EMA für den Kompass-Takt, über 0°/360° hinweg
+float get_kurs_schnell(float cur_head) {
+  if (kurs_schnell < 0) {
+    kurs_schnell = cur_head;
+    return kurs_schnell;
+  }
+  float diff = cur_head - kurs_schnell;
+  if (diff > 180) diff -= 360;
+  if (diff < -180) diff += 360;
+  kurs_schnell += diff * kurs_glaettung;
+  if (kurs_schnell < 0) kurs_schnell += 360;
+  if (kurs_schnell >= 360) kurs_schnell -= 360;
+  return kurs_schnell;
+}
+
+// ganze Grad 0..359 (359,6° wird 0, nicht 360)
+int16_t kursGerundet(float heading) {
+  int16_t deg = (int16_t)lroundf(heading) % 360;
+  if (deg < 0) deg += 360;
+  return deg;
+}
 
 const char* weekdayName(uint8_t wday) {
   static const char* names[] = {
@@ -526,12 +758,48 @@ const char* weekdayName(uint8_t wday) {
 }
 
 void pointOnCircle(int cx, int cy, int r, float heading_deg, int &x, int &y) {
-  float rad = heading_deg * PI / 180.0;  // Grad → Bogenmaß
+  int16_t deg = (int16_t)lroundf(heading_deg);  // Tabelle hat 1°-Auflösung
 
   // Kompasslogik:
   // 0° = oben, 90° = rechts, y-Achse zeigt nach unten
-  x = cx + r * sin(rad);
-  y = cy - r * cos(rad);
+  x = cx + scaleSin(r, deg);
+  y = cy - scaleCos(r, deg);
+}
+
+void renderCompassRose(Adafruit_SSD1306& dis, int16_t heading) {
+  const int cx = SCREEN_WIDTH / 2;
+  const int cy = SCREEN_HEIGHT / 2;
+  const int r  = SCREEN_HEIGHT / 2 - 2;
+
+  // Rose dreht sich, Steuerstrich (lubber line) bleibt oben:
+  // Peilung b steht auf dem Display bei Winkel (b - heading).
+  dis.drawCircle(cx, cy, r, SSD1306_WHITE);
+  for (int16_t b = 0; b < 360; b += 10) {
+    int16_t a = b - heading;
+    int16_t len = (b % 30 == 0) ? 6 : 3;
+    int16_t so = scaleSin(r, a),       co = scaleCos(r, a);
+    int16_t si = scaleSin(r - len, a), ci = scaleCos(r - len, a);
+    dis.drawLine(cx + so, cy - co, cx + si, cy - ci, SSD1306_WHITE);
+  }
+
+  static const char labels[] = { 'N', 'O', 'S', 'W' };
+  dis.setTextSize(1);
+  for (uint8_t i = 0; i < 4; ++i) {
+    int16_t a = i * 90 - heading;
+    // Zeichen ist 5x7, Mittelpunkt auf den Kreis legen
+    dis.setCursor(cx + scaleSin(r - 12, a) - 2, cy - scaleCos(r - 12, a) - 3);
+    dis.print(labels[i]);
+  }
+
+  // Steuerstrich
+  dis.fillTriangle(cx - 3, 0, cx + 3, 0, cx, 6, SSD1306_WHITE);
+  dis.drawFastVLine(cx, cy - r + 7, 6, SSD1306_WHITE);
+
+  // Kurs als Zahl links oben
+  dis.setCursor(0, 0);
+  if (heading < 100) dis.print(F("0"));
+  if (heading < 10) dis.print(F("0"));
+  dis.print(heading);
 }
 
 //////////////////////////////////
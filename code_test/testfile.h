@@ -26,15 +26,35 @@ constexpr int8_t   OLED_RESET =      -1;      // Reset-Pin (oder -1, wenn über
 constexpr uint8_t  SCREEN_ADDRESS =  0x3C;    // I2C-Adresse deines Displays
 
 constexpr uint8_t MPU9250_ADDR =      0x69;
+constexpr uint8_t RTC_SQW_PIN =       2;      // SQW/INT des DS3231 (1 Hz)
 //constexpr uint8_t INT_PIN           2          // optional, falls INT verbunden ist
 
+// Geräte für den gestuften Start (Bitmaske in devices_ok)
+constexpr uint8_t DEV_BME =           0x01;
+constexpr uint8_t DEV_RTC =           0x02;
+constexpr uint8_t DEV_DISPLAY =       0x04;
+constexpr uint8_t DEV_IMU =           0x08;
+constexpr uint8_t DEV_ALL =           0x0F;
+
 constexpr uint8_t array_len = 24;
 constexpr uint8_t mag_mittelwerte = 20;
+constexpr float kurs_glaettung = 0.3f;        // EMA-Faktor im Kompass-Takt (100 ms)
 
 extern uint8_t buttoninput;
+extern unsigned long button_seen_time;
+extern uint16_t button_debounce_time;
+extern bool redraw_pending;
+
+extern unsigned long latency_last_us;
+extern unsigned long latency_max_us;
+
+extern uint8_t devices_ok;
+extern unsigned long boot_first_frame_ms;
 
 extern unsigned long globaltimer;
 extern uint16_t delaytime_for_loop;
+extern unsigned long compasstimer;
+extern uint16_t delaytime_for_compass;
 extern uint8_t counter_for_measurment_within_loop;
 
 extern uint8_t old_hour;
@@ -45,6 +65,7 @@ extern uint8_t mittelwert_divisor;
 
 extern uint8_t current_display;
 extern uint8_t max_number_of_displays;
+extern uint8_t last_rendered_display;
 
 extern uint8_t moon_position_offset_x;
 extern bool moon_going_right;
@@ -60,6 +81,8 @@ extern float  baro_messungen[array_len];
 extern float  mittelwert_magnetkurse[mag_mittelwerte];
 extern uint8_t mag_mittelwert_index;
 extern uint16_t mag_geglaettet;
+extern float kurs_schnell;
+extern int16_t kurs_gezeichnet;
 
 
 /*********************************************
@@ -86,23 +109,37 @@ extern BMEData mittelw_bme;
 Funktionsdeklarationen
 *********************************************/ 
 void systemInit(Adafruit_BME280& bme_var, RTC_DS3231& rtc_var, Adafruit_SSD1306& display_var, MPU9250_WE& imu_var);
+void systemInitRetry(Adafruit_BME280& bme_var, RTC_DS3231& rtc_var, Adafruit_SSD1306& display_var, MPU9250_WE& imu_var);
+bool tryInitDevice(uint8_t device, bool boot, Adafruit_BME280& bme_var, RTC_DS3231& rtc_var, Adafruit_SSD1306& display_var, MPU9250_WE& imu_var);
+bool deviceOk(uint8_t device);
 bool initBME280(Adafruit_BME280& bme_var);
 bool initRTC(RTC_DS3231& rtc_var);
+void rtcSqwBegin(RTC_DS3231& rtc_var);
+DateTime rtcNow(RTC_DS3231& rtc_var);
+bool i2cAck(uint8_t addr);
 bool initDISPLAY(Adafruit_SSD1306& display_var);
-bool initIMU(MPU9250_WE& imu_var);
+bool initIMU(MPU9250_WE& imu_var, bool boot);
 uint8_t updateButtons();
 BMEData updateSensors(Adafruit_BME280& bme_var);
 BMEData get_mittelwert(BMEData& bme_now);
 IMUData updateNavigation(MPU9250_WE& imu_var);
 float get_mag_mittelwert(float cur_head);
+float get_kurs_schnell(float cur_head);
+int16_t kursGerundet(float heading);
 
 void updateMenuSystem(uint8_t button);
+void buttonEdgeBegin();
+void latencyProbeStart();
+void latencyProbeStop();
+void bootFrameProbe();
+void printDeviceStatus(Adafruit_SSD1306& dis);
 void renderDisplay(Adafruit_SSD1306& dis, BMEData& bme_struct, IMUData& imu_struct, DateTime dt, uint8_t displaymode);
 
 void renderDisplay_Setup(Adafruit_SSD1306& dis, uint8_t mode);
 void renderDisplay_everyLoop(Adafruit_SSD1306& dis);
 
 void pointOnCircle(int cx, int cy, int r, float heading_deg, int &x, int &y);
+void renderCompassRose(Adafruit_SSD1306& dis, int16_t heading);
 
 const char* weekdayName(uint8_t wday);
 
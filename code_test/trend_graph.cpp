@@ -0,0 +1,211 @@
+#include "trend_graph.h"
+
+/////////////////////////////////////////
+
+constexpr uint8_t TREND_STEP    = 4;     // Pixel pro Stunde
+constexpr uint8_t TREND_GRAPH_X = SCREEN_WIDTH - 1 - (array_len - 1) * TREND_STEP;
+constexpr uint8_t TREND_BAND_H  = 21;    // 3 Graphen übereinander
+constexpr uint8_t TREND_NO_DATA = 0xFF;
+constexpr uint8_t TREND_NO_INDEX = 99;
+
+struct TrendGraph {
+  float*  values;            // temp_messungen / humid_messungen / baro_messungen
+  float   min_span;          // kleinste Skala, damit Rauschen nicht aufgeblasen wird
+  char    name;
+  uint8_t y_top;
+
+  float   vmin;
+  float   vmax;
+  bool    has_data;
+  bool    rescaled;
+  uint8_t ypix[array_len];   // chronologisch: 0 = ältester, array_len-1 = neuester Wert
+};
+
+TrendGraph trend_graphs[] = {
+  { temp_messungen,  2.0f, 'T', 0 },
+  { humid_messungen, 5.0f, 'H', TREND_BAND_H },
+  { baro_messungen,  4.0f, 'P', 2 * TREND_BAND_H }
+};
+constexpr uint8_t trend_graph_count = sizeof(trend_graphs) / sizeof(trend_graphs[0]);
+
+uint8_t trend_last_index = TREND_NO_INDEX;
+uint8_t trend_pending_shift = 0;
+bool trend_dirty = false;
+bool trend_full = true;
+
+/////////////////////////////////////////
+
+static uint8_t trendX(uint8_t i) {
+  return TREND_GRAPH_X + i * TREND_STEP;
+}
+
+static void trendRange(const TrendGraph& g, float& lo, float& hi) {
+  lo = g.vmin;
+  hi = g.vmax;
+  if (hi - lo < g.min_span) {
+    float mid = (hi + lo) / 2;
+    lo = mid - g.min_span / 2;
+    hi = mid + g.min_span / 2;
+  }
+}
+
+static uint8_t trendY(const TrendGraph& g, float v) {
+  if (v == -1 || !g.has_data) return TREND_NO_DATA;
+  float lo, hi;
+  trendRange(g, lo, hi);
+  // Zeichenfläche: y_top+1 .. y_top+TREND_BAND_H-2
+  float rel = (v - lo) / (hi - lo);
+  return g.y_top + TREND_BAND_H - 2 - (uint8_t)lroundf(rel * (TREND_BAND_H - 3));
+}
+
+static void trendRescan(TrendGraph& g) {
+  g.has_data = false;
+  for (uint8_t i = 0; i < array_len; ++i) {
+    float v = g.values[i];
+    if (v == -1) continue;
+    if (!g.has_data || v < g.vmin) g.vmin = v;
+    if (!g.has_data || v > g.vmax) g.vmax = v;
+    g.has_data = true;
+  }
+}
+
+static void trendRebuild(TrendGraph& g, uint8_t newest) {
+  for (uint8_t i = 0; i < array_len; ++i) {
+    uint8_t slot = (newest + 1 + i) % array_len;
+    g.ypix[i] = trendY(g, g.values[slot]);
+  }
+}
+
+static void trendDrawSegment(Adafruit_SSD1306& dis, const TrendGraph& g, uint8_t i) {
+  uint8_t y1 = g.ypix[i];
+  if (y1 == TREND_NO_DATA) return;
+  uint8_t y0 = (i > 0) ? g.ypix[i - 1] : TREND_NO_DATA;
+  if (y0 == TREND_NO_DATA) {
+    dis.drawPixel(trendX(i), y1, SSD1306_WHITE);
+  } else {
+    dis.drawLine(trendX(i - 1), y0, trendX(i), y1, SSD1306_WHITE);
+  }
+}
+
+static void trendDrawBand(Adafruit_SSD1306& dis, const TrendGraph& g) {
+  dis.fillRect(TREND_GRAPH_X, g.y_top, SCREEN_WIDTH - TREND_GRAPH_X, TREND_BAND_H, SSD1306_BLACK);
+  for (uint8_t i = 0; i < array_len; ++i) {
+    trendDrawSegment(dis, g, i);
+  }
+}
+
+static void trendDrawLabel(Adafruit_SSD1306& dis, const TrendGraph& g) {
+  dis.fillRect(0, g.y_top, TREND_GRAPH_X, TREND_BAND_H, SSD1306_BLACK);
+  dis.setTextSize(1);
+  dis.setCursor(0, g.y_top + 2);
+  dis.print(g.name);
+  dis.setCursor(0, g.y_top + 11);
+  float v = (trend_last_index == TREND_NO_INDEX) ? -1 : g.values[trend_last_index];
+  if (v == -1) {
+    dis.print(F("--"));
+  } else {
+    dis.print(v, 1);
+  }
+}
+
+/////////////////////////////////////////
+
+void trendBegin() {
+  for (uint8_t k = 0; k < trend_graph_count; ++k) {
+    trendRescan(trend_graphs[k]);
+    memset(trend_graphs[k].ypix, TREND_NO_DATA, array_len);
+  }
+  trend_last_index = TREND_NO_INDEX;
+  trend_full = true;
+}
+
+void trendStoreBucket(uint8_t index, const BMEData& value) {
+  const float new_values[] = { value.temp, value.humi, value.baro };
+
+  // 0 = neuester Wert wird ersetzt, 1 = neue Stunde, >1 = Lücke (Gerät war aus)
+  uint8_t shift = (trend_last_index == TREND_NO_INDEX)
+                  ? array_len
+                  : (index + array_len - trend_last_index) % array_len;
+
+  for (uint8_t k = 0; k < trend_graph_count; ++k) {
+    TrendGraph& g = trend_graphs[k];
+    float old_v = g.values[index];
+    float new_v = new_values[k];
+    g.values[index] = new_v;
+
+    float lo, hi;
+    trendRange(g, lo, hi);
+
+    if (shift > 1) {
+      trendRescan(g);
+    } else if (old_v != -1 && (old_v <= g.vmin || old_v >= g.vmax)) {
+      // Extremwert fällt raus -> einmal neu suchen (24 Vergleiche)
+      trendRescan(g);
+    } else if (new_v != -1) {
+      if (!g.has_data || new_v < g.vmin) g.vmin = new_v;
+      if (!g.has_data || new_v > g.vmax) g.vmax = new_v;
+      g.has_data = true;
+    }
+
+    float new_lo, new_hi;
+    trendRange(g, new_lo, new_hi);
+    if (shift > 1 || new_lo != lo || new_hi != hi) {
+      trendRebuild(g, index);
+      g.rescaled = true;
+    } else {
+      if (shift == 1) memmove(g.ypix, g.ypix + 1, array_len - 1);
+      g.ypix[array_len - 1] = trendY(g, new_v);
+    }
+  }
+
+  if (shift > 1) trend_full = true;
+  trend_pending_shift += shift;
+  trend_last_index = index;
+  trend_dirty = true;
+}
+
+bool trendRender(Adafruit_SSD1306& dis, bool full) {
+  if (full || trend_full || trend_pending_shift > 1) {
+    dis.clearDisplay();
+    for (uint8_t k = 0; k < trend_graph_count; ++k) {
+      trendDrawBand(dis, trend_graphs[k]);
+      trendDrawLabel(dis, trend_graphs[k]);
+      trend_graphs[k].rescaled = false;
+    }
+    trend_full = false;
+    trend_pending_shift = 0;
+    trend_dirty = false;
+    return true;
+  }
+
+  if (!trend_dirty) return false;
+
+  if (trend_pending_shift == 1) {
+    // Framebuffer ist seitenweise organisiert (8 Pixel hoch, 1 Byte pro Spalte):
+    // Schieben = memmove pro Seite, danach die freien Spalten löschen.
+    uint8_t* buf = dis.getBuffer();
+    for (uint8_t page = 0; page < SCREEN_HEIGHT / 8; ++page) {
+      uint8_t* row = buf + page * SCREEN_WIDTH;
+      memmove(row + TREND_GRAPH_X, row + TREND_GRAPH_X + TREND_STEP,
+              SCREEN_WIDTH - TREND_GRAPH_X - TREND_STEP);
+      memset(row + SCREEN_WIDTH - TREND_STEP, 0, TREND_STEP);
+    }
+  }
+
+  for (uint8_t k = 0; k < trend_graph_count; ++k) {
+    TrendGraph& g = trend_graphs[k];
+    if (g.rescaled) {
+      trendDrawBand(dis, g);
+      g.rescaled = false;
+    } else {
+      // nur das neueste Segment (ersetzt oder neu eingeschoben)
+      dis.fillRect(trendX(array_len - 2) + 1, g.y_top, TREND_STEP, TREND_BAND_H, SSD1306_BLACK);
+      trendDrawSegment(dis, g, array_len - 1);
+    }
+    trendDrawLabel(dis, g);
+  }
+
+  trend_pending_shift = 0;
+  trend_dirty = false;
+  return true;
+}
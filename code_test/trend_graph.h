@@ -0,0 +1,23 @@
+#pragma once
+
+#include "testfile.h"
+
+/*********************************************
+Verlaufsgraphen (24 h) für Temp/Hygro/Baro
+
+Die Stundenwerte werden über trendStoreBucket() abgelegt.
+Der Graph hält pro Stunde die fertige Pixel-Y-Position und
+min/max werden beim Eintragen nachgeführt. Beim Zeichnen wird
+der Framebuffer nur um eine Spalte geschoben und das neue
+Segment gezeichnet; voll neu gezeichnet wird nur bei
+Skalenänderung oder beim Wechsel auf den Screen.
+*********************************************/
+
+void trendBegin();
+
+// Schreibt den Stundenwert in temp/humid/baro_messungen[index]
+// und führt Skala + Pixelcache nach.
+void trendStoreBucket(uint8_t index, const BMEData& value);
+
+// Liefert true, wenn sich der Framebuffer geändert hat (-> display()).
+bool trendRender(Adafruit_SSD1306& dis, bool full);
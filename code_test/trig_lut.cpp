@@ -0,0 +1,60 @@
+#include "trig_lut.h"
+
+/////////////////////////////////////////
+
+// Taylorreihe bis x^23: auf 0..pi/2 genauer als ein Q15-Schritt.
+// (C++11-constexpr: nur ein return-Ausdruck, daher rekursiv)
+constexpr double taylorSin(double x2, double term, int k) {
+  return k > 11 ? term
+                : term + taylorSin(x2, -term * x2 / ((2.0 * k) * (2.0 * k + 1.0)), k + 1);
+}
+
+constexpr double degToRad(int deg) {
+  return deg * 3.14159265358979323846 / 180.0;
+}
+
+constexpr int16_t sinQ15(int deg) {
+  return (int16_t)(taylorSin(degToRad(deg) * degToRad(deg), degToRad(deg), 1) * TRIG_ONE + 0.5);
+}
+
+static_assert(sinQ15(90) == TRIG_ONE, "sinQ15 muss zur Compile-Zeit auswertbar sein");
+
+#define SIN_ROW(d) \
+  sinQ15(d + 0), sinQ15(d + 1), sinQ15(d + 2), sinQ15(d + 3), sinQ15(d + 4), \
+  sinQ15(d + 5), sinQ15(d + 6), sinQ15(d + 7), sinQ15(d + 8), sinQ15(d + 9)
+
+const int16_t sin_quarter[91] PROGMEM = {
+  SIN_ROW(0),  SIN_ROW(10), SIN_ROW(20),
+  SIN_ROW(30), SIN_ROW(40), SIN_ROW(50),
+  SIN_ROW(60), SIN_ROW(70), SIN_ROW(80),
+  sinQ15(90)
+};
+
+#undef SIN_ROW
+
+/////////////////////////////////////////
+
+int16_t sinDeg(int16_t deg) {
+  deg %= 360;
+  if (deg < 0) deg += 360;
+
+  // Viertelwelle spiegeln
+  if (deg <= 90)  return  (int16_t)pgm_read_word(&sin_quarter[deg]);
+  if (deg <= 180) return  (int16_t)pgm_read_word(&sin_quarter[180 - deg]);
+  if (deg <= 270) return -(int16_t)pgm_read_word(&sin_quarter[deg - 180]);
+  return -(int16_t)pgm_read_word(&sin_quarter[360 - deg]);
+}
+
+int16_t cosDeg(int16_t deg) {
+  return sinDeg(deg + 90);
+}
+
+int16_t scaleSin(int16_t r, int16_t deg) {
+  int32_t v = (int32_t)r * sinDeg(deg);
+  return (int16_t)((v + (v >= 0 ? 16384 : -16384)) / 32768);
+}
+
+int16_t scaleCos(int16_t r, int16_t deg) {
+  int32_t v = (int32_t)r * cosDeg(deg);
+  return (int16_t)((v + (v >= 0 ? 16384 : -16384)) / 32768);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Arduino.h>
+
+/*********************************************
+Sinus/Cosinus über Tabelle (PROGMEM)
+
+Viertelwelle 0..90° in 1°-Schritten, Festkomma Q15
+(32767 = 1.0). Die Tabelle wird zur Compile-Zeit per
+constexpr berechnet, zur Laufzeit gibt es kein sin()/cos().
+*********************************************/
+
+constexpr int16_t TRIG_ONE = 32767;
+
+int16_t sinDeg(int16_t deg);   // Q15, beliebiger Winkel in Grad
+int16_t cosDeg(int16_t deg);   // Q15, beliebiger Winkel in Grad
+
+// r * sin/cos, gerundet auf ganze Pixel
+int16_t scaleSin(int16_t r, int16_t deg);
+int16_t scaleCos(int16_t r, int16_t deg);
@@ -0,0 +1,272 @@
+/*
+Rolle: Regelbasierte Alarmauswertung.
+
+Inhalt:
+
+Zustand pro Regel (wartet auf Haltezeit / aktiv)
+
+Hysterese: ein aktiver Alarm geht erst zurück, wenn der Wert die
+Schwelle um die Hysterese in Gegenrichtung unterschritten hat
+
+Buzzer spielt das Muster der höchsten aktiven Regel
+
+Regeln als ein Wert im Config-Store (Magic, Version, Prüfsumme bleiben);
+der alte feste EEPROM-Block wird beim ersten Start übernommen
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "config.h"
+#include "config_store.h"
+#include "alarms.h"
+
+namespace {
+
+  const AlarmRule DEFAULT_RULES[] PROGMEM = {
+    // Krängung über 30° (beide Seiten)
+    { Channel::Roll,           AlarmCompare::AbsAbove, 300, 30,  3, BuzzerPattern::AlarmWarning, true },
+    // Luftdruck fällt mehr als 4 hPa in 3 h
+    { Channel::PressureTrend,  AlarmCompare::Below,    -40, 5,  60, BuzzerPattern::AlarmWarning, true },
+    // Akku unter 15 %
+    { Channel::BatteryPercent, AlarmCompare::Below,     15, 3,  30, BuzzerPattern::AlarmInfo,    true },
+    // Frost: unter 3,0 °C
+    { Channel::Temperature,    AlarmCompare::Below,     30, 10, 60, BuzzerPattern::AlarmInfo,    false }
+  };
+  constexpr uint8_t RULE_COUNT = sizeof(DEFAULT_RULES) / sizeof(DEFAULT_RULES[0]);
+
+  struct RuleState {
+    uint16_t lastSeq;
+    bool pending;
+    bool active;
+    unsigned long pendingSince;
+  };
+
+  AlarmRule rules[RULE_COUNT];
+  RuleState states[RULE_COUNT];
+  bool dirty = false;
+  bool muted = false;
+  int8_t soundingRule = -1;
+
+  constexpr uint16_t ALARM_MAGIC = 0xA1A2;
+  constexpr uint8_t  ALARM_VERSION = 1;
+
+  struct AlarmConfigBlock {
+    uint16_t  magic;
+    uint8_t   version;
+    uint8_t   count;
+    AlarmRule rules[RULE_COUNT];
+    uint8_t   checksum;
+  };
+
+  static_assert(sizeof(AlarmConfigBlock) <= CONFIG_MAX_VALUE, "Alarmregeln passen nicht in den Config-Store");
+
+  uint8_t checksum(const AlarmConfigBlock& block) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&block);
+    uint8_t sum = 0;
+    for (size_t i = 0; i < offsetof(AlarmConfigBlock, checksum); ++i) {
+      sum = (sum << 1 | sum >> 7) ^ p[i];   // rotieren + xor: erkennt auch vertauschte Bytes
+    }
+    return sum;
+  }
+
+  bool isValid(const AlarmConfigBlock& block) {
+    return block.magic == ALARM_MAGIC && block.version == ALARM_VERSION
+           && block.count == RULE_COUNT && block.checksum == checksum(block);
+  }
+
+  void loadDefaults() {
+    memcpy_P(rules, DEFAULT_RULES, sizeof(rules));
+  }
+
+  bool conditionTrue(const AlarmRule& r, int16_t v, bool active) {
+    // Aktive Alarme bekommen die Hysterese als Rückfallschwelle
+    int16_t hyst = active ? r.hysteresis : 0;
+    switch (r.compare) {
+      case AlarmCompare::Above:    return v > r.threshold - hyst;
+      case AlarmCompare::Below:    return v < r.threshold + hyst;
+      case AlarmCompare::AbsAbove: return abs(v) > r.threshold - hyst;
+    }
+    return false;
+  }
+
+  void evaluate(uint8_t i, unsigned long now) {
+    const AlarmRule& r = rules[i];
+    RuleState& s = states[i];
+
+    if (!conditionTrue(r, DataStore::getRaw(r.channel), s.active)) {
+      s.pending = false;
+      s.active = false;
+      return;
+    }
+    if (!s.active && !s.pending) {
+      s.pending = true;
+      s.pendingSince = now;
+    }
+  }
+
+  void updateSound() {
+    // höchstes Muster unter den aktiven Regeln
+    int8_t best = -1;
+    for (uint8_t i = 0; i < RULE_COUNT; ++i) {
+      if (!states[i].active) continue;
+      if (best < 0 || rules[i].pattern > rules[best].pattern) best = i;
+    }
+
+    if (best < 0) {
+      if (soundingRule >= 0) Buzzer::alarmOff(rules[soundingRule].pattern);
+      soundingRule = -1;
+      muted = false;
+      return;
+    }
+    if (best != soundingRule && !muted) {
+      // Buzzer lässt ein niedrigeres Muster nicht über ein laufendes höheres;
+      // das Muster der nicht mehr aktiven Regel also erst beenden
+      if (soundingRule >= 0) Buzzer::alarmOff(rules[soundingRule].pattern);
+      Buzzer::alarmOn(rules[best].pattern);
+      soundingRule = best;
+    }
+  }
+
+}
+
+namespace Alarms {
+
+  void begin() {
+    AlarmConfigBlock block;
+    if (ConfigStore::get(ConfigKey::AlarmRules, &block, sizeof(block)) && isValid(block)) {
+      memcpy(rules, block.rules, sizeof(rules));
+    } else {
+      // vor dem Config-Store: fester Block, einmal übernehmen
+      EEPROM.get(EEPROM_ADDR_ALARM_RULES, block);
+      if (isValid(block)) {
+        memcpy(rules, block.rules, sizeof(rules));
+        ConfigStore::set(ConfigKey::AlarmRules, &block, sizeof(block));
+      } else {
+        loadDefaults();
+      }
+    }
+
+    for (uint8_t i = 0; i < RULE_COUNT; ++i) {
+      // lastSeq absichtlich != aktueller Seq, damit jede Regel einmal bewertet wird
+      states[i].lastSeq = DataStore::getSeq(rules[i].channel) - 1;
+      states[i].pending = false;
+      states[i].active = false;
+    }
+    dirty = false;
+    muted = false;
+    soundingRule = -1;
+  }
+
+  void update() {
+    unsigned long now = millis();
+    bool changed = false;
+
+    for (uint8_t i = 0; i < RULE_COUNT; ++i) {
+      RuleState& s = states[i];
+      if (!rules[i].enabled) {
+        if (s.active || s.pending) changed = true;
+        s.active = false;
+        s.pending = false;
+        continue;
+      }
+
+      bool wasActive = s.active;
+      // noch nie veröffentlicht: getRaw() liefert 0, kein Messwert
+      if (!DataStore::isValid(rules[i].channel)) continue;
+      if (DataStore::changed(rules[i].channel, s.lastSeq)) {
+        evaluate(i, now);
+      }
+      // Haltezeit läuft auch ohne neuen Wert ab
+      if (s.pending && now - s.pendingSince >= rules[i].holdOffS * 1000UL) {
+        s.pending = false;
+        s.active = true;
+        muted = false;     // neue Auslösung hebt Quittierung auf
+      }
+      if (s.active != wasActive) changed = true;
+    }
+
+    if (changed) updateSound();
+    // von einem anderen Alarm (Knockdown) überdeckt oder abgeschaltet: wieder an
+    if (soundingRule >= 0 && !Buzzer::isPlaying()) Buzzer::alarmOn(rules[soundingRule].pattern);
+  }
+
+  bool isActive(uint8_t rule) {
+    return rule < RULE_COUNT && states[rule].active;
+  }
+
+  bool anyActive() {
+    for (uint8_t i = 0; i < RULE_COUNT; ++i) {
+      if (states[i].active) return true;
+    }
+    return false;
+  }
+
+  void acknowledge() {
+    if (soundingRule < 0) return;
+    Buzzer::alarmOff(rules[soundingRule].pattern);
+    muted = true;
+    soundingRule = -1;
+  }
+
+  uint8_t getRuleCount() {
+    return RULE_COUNT;
+  }
+
+  const AlarmRule& getRule(uint8_t rule) {
+    return rules[rule < RULE_COUNT ? rule : 0];
+  }
+
+  void adjust(uint8_t rule, AlarmField field, int16_t delta) {
+    if (rule >= RULE_COUNT) return;
+    AlarmRule& r = rules[rule];
+
+    switch (field) {
+      case AlarmField::Enabled:
+        r.enabled = !r.enabled;
+        break;
+      case AlarmField::Threshold:
+        r.threshold += delta;
+        break;
+      case AlarmField::Hysteresis:
+        r.hysteresis = max(0, r.hysteresis + delta);
+        break;
+      case AlarmField::HoldOff:
+        // uint16_t: über 32767 s ergäbe ein Cast auf int16_t negative Werte
+        if (delta < 0) {
+          uint16_t down = (uint16_t)(-delta);
+          r.holdOffS = r.holdOffS > down ? r.holdOffS - down : 0;
+        } else {
+          r.holdOffS = r.holdOffS < UINT16_MAX - delta ? r.holdOffS + delta : UINT16_MAX;
+        }
+        break;
+      case AlarmField::Pattern: {
+        // nur die Alarm-Muster durchschalten
+        const int8_t first = static_cast<int8_t>(BuzzerPattern::AlarmInfo);
+        const int8_t span = static_cast<int8_t>(BuzzerPattern::COUNT) - first;
+        int8_t p = static_cast<int8_t>(r.pattern) - first;
+        p = ((p + (delta < 0 ? -1 : 1)) % span + span) % span;
+        r.pattern = static_cast<BuzzerPattern>(p + first);
+        break;
+      }
+      default:
+        return;
+    }
+
+    // mit neuer Schwelle beim nächsten update() neu bewerten
+    states[rule].lastSeq = DataStore::getSeq(r.channel) - 1;
+    dirty = true;
+  }
+
+  void save() {
+    if (!dirty) return;
+    AlarmConfigBlock block;
+    block.magic = ALARM_MAGIC;
+    block.version = ALARM_VERSION;
+    block.count = RULE_COUNT;
+    memcpy(block.rules, rules, sizeof(rules));
+    block.checksum = checksum(block);
+    ConfigStore::set(ConfigKey::AlarmRules, &block, sizeof(block));   // schreibt verzögert, unverändert gar nicht
+    dirty = false;
+  }
+
+}
@@ -0,0 +1,60 @@
+/*
+Rolle: Regelbasierte Alarmauswertung.
+
+Inhalt:
+
+Tabelle von Regeln: Datenkanal + Vergleich + Schwelle + Hysterese
++ Haltezeit + Buzzer-Muster
+
+Eine Regel wird nur neu bewertet, wenn sich ihr Kanal im DataStore
+geändert hat (Sequenznummer), nicht in jeder Loop-Runde
+
+Regeln sind im Settings-Screen änderbar und liegen im EEPROM
+*/
+
+#pragma once
+#include <stdint.h>
+#include "data_store.h"
+#include "buzzer.h"
+
+enum class AlarmCompare : uint8_t {
+  Above,      // Wert > Schwelle
+  Below,      // Wert < Schwelle
+  AbsAbove    // |Wert| > Schwelle (z. B. Krängung nach beiden Seiten)
+};
+
+// Schwelle und Hysterese in der quantisierten Einheit des Kanals
+// (siehe enum Channel, z. B. 0,1 ° bei Roll).
+struct AlarmRule {
+  Channel       channel;
+  AlarmCompare  compare;
+  int16_t       threshold;
+  int16_t       hysteresis;
+  uint16_t      holdOffS;     // Bedingung muss so lange anstehen, bevor der Alarm auslöst
+  BuzzerPattern pattern;
+  bool          enabled;
+};
+
+enum class AlarmField : uint8_t {
+  Enabled,
+  Threshold,
+  Hysteresis,
+  HoldOff,
+  Pattern,
+  COUNT
+};
+
+namespace Alarms {
+  void begin();               // lädt Regeln aus dem EEPROM (oder Defaults)
+  void update();              // aus handleAlarms()
+
+  bool isActive(uint8_t rule);
+  bool anyActive();
+  void acknowledge();         // Ton aus, bis eine Regel neu auslöst
+
+  // Settings-Screen
+  uint8_t getRuleCount();
+  const AlarmRule& getRule(uint8_t rule);
+  void adjust(uint8_t rule, AlarmField field, int16_t delta);
+  void save();                // an den Config-Store, nur wenn sich etwas geändert hat
+}
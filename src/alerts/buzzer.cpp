@@ -3,11 +3,190 @@ Rolle: Akustische Signale & Alarme.
 
 Inhalt:
 
-Abstraktion für:
+Sequencer für Tonfolgen (Frequenz/Dauer/Wiederholungen) aus PROGMEM
 
-kurzer Beep (Button-Feedback)
+Läuft nie blockierend: entweder im Timer0-Compare-ISR (etwa 1 kHz,
+Timer0-Overflow bleibt für millis() unberührt) oder über Buzzer::update()
 
-Pattern für Alarm
-
-evtl. non-blocking Tonsteuerung über millis()
+tone()/noTone() erzeugen den Ton selbst per Hardware-Timer
 */
+
+#include <Arduino.h>
+#include "config.h"
+#include "buzzer.h"
+
+namespace {
+
+  struct Note {
+    uint16_t freq;         // Hz, 0 = Pause
+    uint16_t durationMs;
+  };
+
+  struct PatternDef {
+    const Note* notes;
+    uint8_t count;
+    uint8_t repeat;        // 0 = bis stop()/alarmOff()
+  };
+
+  const Note notes_ok[] PROGMEM = {
+    { 2000, 40 }
+  };
+  const Note notes_error[] PROGMEM = {
+    { 400, 150 }, { 0, 80 }, { 400, 150 }
+  };
+  const Note notes_alarm_info[] PROGMEM = {
+    { 1500, 80 }, { 0, 80 }, { 1500, 80 }, { 0, 2000 }
+  };
+  const Note notes_alarm_warning[] PROGMEM = {
+    { 2500, 200 }, { 0, 200 }, { 2500, 200 }, { 0, 1000 }
+  };
+  const Note notes_alarm_critical[] PROGMEM = {
+    { 3000, 150 }, { 2000, 150 }
+  };
+
+  const PatternDef patterns[] PROGMEM = {
+    { notes_ok,             sizeof(notes_ok) / sizeof(Note),             1 },
+    { notes_error,          sizeof(notes_error) / sizeof(Note),          1 },
+    { notes_alarm_info,     sizeof(notes_alarm_info) / sizeof(Note),     0 },
+    { notes_alarm_warning,  sizeof(notes_alarm_warning) / sizeof(Note),  0 },
+    { notes_alarm_critical, sizeof(notes_alarm_critical) / sizeof(Note), 0 }
+  };
+
+  // Zustand wird im ISR gelesen/geschrieben
+  volatile bool active = false;
+  volatile uint8_t current = 0;
+  volatile uint8_t noteIndex = 0;
+  volatile uint8_t repeatsLeft = 0;
+  volatile unsigned long noteEnd = 0;
+
+  PatternDef readPattern(uint8_t id) {
+    PatternDef p;
+    memcpy_P(&p, &patterns[id], sizeof(p));
+    return p;
+  }
+
+  void startNote(const PatternDef& p, unsigned long now) {
+    Note n;
+    memcpy_P(&n, &p.notes[noteIndex], sizeof(n));
+    if (n.freq) {
+      tone(PIN_BUZZER, n.freq);
+    } else {
+      noTone(PIN_BUZZER);
+    }
+    noteEnd = now + n.durationMs;
+  }
+
+  // Ein Sequencer-Schritt; aus ISR oder mit gesperrten Interrupts aufrufen.
+  void advance(unsigned long now) {
+    if (!active) return;
+    if ((long)(now - noteEnd) < 0) return;
+
+    PatternDef p = readPattern(current);
+    noteIndex++;
+    if (noteIndex >= p.count) {
+      noteIndex = 0;
+      if (p.repeat != 0 && --repeatsLeft == 0) {
+        noTone(PIN_BUZZER);
+        active = false;
+        return;
+      }
+    }
+    startNote(p, now);
+  }
+
+  // Auch aus einem ISR aufrufbar (Knockdown): Interrupt-Zustand wird
+  // gesichert statt pauschal wieder freigegeben.
+  void start(BuzzerPattern pattern) {
+    uint8_t id = static_cast<uint8_t>(pattern);
+    if (id >= static_cast<uint8_t>(BuzzerPattern::COUNT)) return;
+
+    uint8_t sreg = SREG;
+    noInterrupts();
+    // laufende höher priorisierte Folge nicht unterbrechen
+    if (!active || id >= current) {
+      PatternDef p = readPattern(id);
+      current = id;
+      noteIndex = 0;
+      repeatsLeft = p.repeat;
+      active = true;
+      startNote(p, millis());
+    }
+    SREG = sreg;
+  }
+
+}
+
+#if BUZZER_USE_TIMER0_ISR
+// Timer0 läuft für millis() ohnehin mit ~1 kHz; der Compare-A-Interrupt
+// hängt sich daran an, ohne den Overflow-Interrupt zu stören.
+ISR(TIMER0_COMPA_vect) {
+  advance(millis());
+}
+#endif
+
+namespace Buzzer {
+
+  void begin() {
+    pinMode(PIN_BUZZER, OUTPUT);
+    noTone(PIN_BUZZER);
+    active = false;
+#if BUZZER_USE_TIMER0_ISR
+    OCR0A = 0x80;
+    TIMSK0 |= _BV(OCIE0A);
+#endif
+  }
+
+  void beepOk() {
+    start(BuzzerPattern::Ok);
+  }
+
+  void beepError() {
+    start(BuzzerPattern::Error);
+  }
+
+  void alarmOn(BuzzerPattern pattern) {
+    start(pattern);
+  }
+
+  void alarmOff() {
+    noInterrupts();
+    if (active && current >= static_cast<uint8_t>(BuzzerPattern::AlarmInfo)) {
+      noTone(PIN_BUZZER);
+      active = false;
+    }
+    interrupts();
+  }
+
+  void alarmOff(BuzzerPattern pattern) {
+    noInterrupts();
+    if (active && current == static_cast<uint8_t>(pattern)) {
+      noTone(PIN_BUZZER);
+      active = false;
+    }
+    interrupts();
+  }
+
+  void play(BuzzerPattern pattern) {
+    start(pattern);
+  }
+
+  void stop() {
+    noInterrupts();
+    noTone(PIN_BUZZER);
+    active = false;
+    interrupts();
+  }
+
+  bool isPlaying() {
+    return active;
+  }
+
+  void update() {
+#if !BUZZER_USE_TIMER0_ISR
+    noInterrupts();
+    advance(millis());
+    interrupts();
+#endif
+  }
+
+}
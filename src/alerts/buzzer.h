@@ -13,13 +13,28 @@ evtl. non-blocking Tonsteuerung über millis()
 */
 
 #pragma once
+#include <stdint.h>
+
+// Tonfolgen aus der PROGMEM-Tabelle in buzzer.cpp.
+// Reihenfolge = Priorität: eine höhere Folge wird nicht von einer niedrigeren unterbrochen.
+enum class BuzzerPattern : uint8_t {
+  Ok,
+  Error,
+  AlarmInfo,
+  AlarmWarning,
+  AlarmCritical,
+  COUNT
+};
 
 namespace Buzzer {
   void begin();
   void beepOk();
   void beepError();
-  void alarmOn();
+  void alarmOn(BuzzerPattern pattern = BuzzerPattern::AlarmWarning);
   void alarmOff();
-  void update();   // für zeitbasierte Tonmuster
+  void alarmOff(BuzzerPattern pattern);   // nur, wenn gerade dieses Muster läuft
+  void play(BuzzerPattern pattern);
+  void stop();
+  bool isPlaying();
+  void update();   // für zeitbasierte Tonmuster (ohne Timer0-ISR)
 }
-
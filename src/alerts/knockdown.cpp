@@ -0,0 +1,102 @@
+/*
+Rolle: Knockdown-/Krängungsalarm im Interrupt.
+
+Inhalt:
+
+Krängung θ aus der Schwerkraft: tan θ = lateral / vertikal.
+|θ| > θ0  <=>  |lateral| * cos θ0 > vertikal * sin θ0
+(gilt auch für vertikal <= 0, dann liegt das Boot über 90°).
+cos/sin werden in begin() als Q10-Ganzzahlen abgelegt, im ISR gibt es
+nur zwei 32-Bit-Multiplikationen und einen Vergleich.
+*/
+
+#include <Arduino.h>
+#include "config.h"
+#include "data_store.h"
+#include "buzzer.h"
+#include "knockdown.h"
+
+namespace {
+
+  int32_t cosQ10 = 0;
+  int32_t sinQ10 = 0;
+  int16_t heelLimitRaw = 0;               // 0,1 ° wie Channel::Roll
+
+  volatile uint8_t overCount = 0;         // aufeinanderfolgende Samples über der Schwelle
+  volatile KnockdownState state = KnockdownState::Idle;
+  volatile unsigned long eventTime = 0;
+
+  constexpr unsigned long CLASSIFY_DELAY_MS = 500;   // gefilterte Werte müssen nachziehen
+
+}
+
+namespace Knockdown {
+
+  void begin(float heelDeg) {
+    float rad = heelDeg * PI / 180.0f;
+    cosQ10 = lroundf(cosf(rad) * 1024.0f);
+    sinQ10 = lroundf(sinf(rad) * 1024.0f);
+    heelLimitRaw = (int16_t)lroundf(heelDeg * 10.0f);
+    overCount = 0;
+    state = KnockdownState::Idle;
+  }
+
+  void checkSample(int16_t lateral, int16_t vertical) {
+    int32_t lat = lateral < 0 ? -(int32_t)lateral : lateral;
+    bool over = lat * cosQ10 > (int32_t)vertical * sinQ10;
+
+    if (!over) {
+      overCount = 0;
+      return;
+    }
+    if (overCount < KNOCKDOWN_SAMPLES) overCount++;
+    if (overCount == KNOCKDOWN_SAMPLES && state == KnockdownState::Idle) {
+      state = KnockdownState::Latched;
+      eventTime = millis();
+      Buzzer::alarmOn(BuzzerPattern::AlarmCritical);
+    }
+  }
+
+  void update() {
+    if (state == KnockdownState::Confirmed) {
+      // Alarms::update() kann den Buzzer beim Abklingen einer Regel abschalten
+      if (!Buzzer::isPlaying()) Buzzer::alarmOn(BuzzerPattern::AlarmCritical);
+      return;
+    }
+    if (state != KnockdownState::Latched) return;
+
+    noInterrupts();
+    unsigned long t = eventTime;
+    interrupts();
+    if (millis() - t < CLASSIFY_DELAY_MS) return;
+
+    int16_t roll = DataStore::getRaw(Channel::Roll);
+    if (abs(roll) >= heelLimitRaw) {
+      state = KnockdownState::Confirmed;   // bleibt bis acknowledge()
+    } else {
+      // Welle/Stoß: Spitze im Rohsignal, gefilterte Krängung unauffällig.
+      // Nur das eigene Muster beenden, ein Regelalarm darunter meldet sich
+      // in Alarms::update() wieder
+      Buzzer::alarmOff(BuzzerPattern::AlarmCritical);
+      state = KnockdownState::Idle;
+    }
+  }
+
+  KnockdownState getState() {
+    return state;
+  }
+
+  unsigned long getEventTime() {
+    noInterrupts();
+    unsigned long t = eventTime;
+    interrupts();
+    return t;
+  }
+
+  void acknowledge() {
+    if (state == KnockdownState::Idle) return;
+    Buzzer::alarmOff(BuzzerPattern::AlarmCritical);
+    state = KnockdownState::Idle;
+  }
+
+}
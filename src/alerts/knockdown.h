@@ -0,0 +1,28 @@
+/*
+Rolle: Knockdown-/Krängungsalarm im Interrupt.
+
+Inhalt:
+
+Schwelle wird einmal in Festkomma vorberechnet (kein atan2 im ISR)
+
+checkSample() läuft im Data-Ready-ISR der IMU: Auswertung der
+Roh-Beschleunigung, Ereignis mit Zeitstempel merken, Buzzer sofort starten
+
+update() im Hauptprogramm klassifiziert das Ereignis später mit der
+gefilterten Krängung: bestätigt (Alarm bleibt) oder kurzer Ausreißer
+(Alarm wieder aus)
+*/
+
+#pragma once
+#include <stdint.h>
+
+enum class KnockdownState : uint8_t { Idle, Latched, Confirmed };
+
+namespace Knockdown {
+  void begin(float heelDeg);
+  void checkSample(int16_t lateral, int16_t vertical);   // ISR-fest
+  void update();
+  KnockdownState getState();
+  unsigned long getEventTime();                          // millis() der Auslösung
+  void acknowledge();
+}
@@ -15,17 +15,116 @@ Compile-Time-Flags (z. B. #define DEBUG 1)
 #pragma once
 
 // Pins
-constexpr int PIN_BUTTON_1 = 2;
-constexpr int PIN_BUTTON_2 = 3;
-// ...
+// Taster: active low (INPUT_PULLUP), Reihenfolge = buttonId 1..n.
+// Alle Taster brauchen einen Pin-Change-Interrupt, sonst geht ein kurzer
+// Druck während einer langen loop()-Runde verloren. PCINT-fähig auf dem
+// Mega 2560: 10-13, 50-53, A8-A15 (12 = Buzzer, 50-53 = SD).
+constexpr uint8_t BUTTON_PINS[] = { A8, A9, 10, 11 };
+constexpr uint8_t BUTTON_COUNT  = sizeof(BUTTON_PINS);
+
+// EEPROM-Layout
+constexpr int EEPROM_ADDR_CONFIG      = 0;      // Config-Store: 2 Seiten (config_store.h)
+constexpr int EEPROM_CONFIG_PAGE_BYTES = 512;
+constexpr int EEPROM_ADDR_ALARM_RULES = 64;     // alter fester Alarmblock, nur noch zum Übernehmen
+constexpr int EEPROM_ADDR_HISTORY     = 1024;   // Stundenverlauf T/H/P bis zum Ende (4 KB)
+constexpr int EEPROM_HISTORY_BYTES    = 3072;
+
+// Config-Store: Änderungen innerhalb dieser Zeit werden zusammengefasst (ms)
+constexpr unsigned long CONFIG_COALESCE_MS = 5000;
+
+// Buzzer (wie simple_buzzer_example: Buzzer 12)
+constexpr uint8_t PIN_BUZZER = 12;
+// 1 = Tonfolgen laufen im Timer0-Compare-ISR weiter (auch wenn loop() hängt),
+// 0 = nur über Buzzer::update()
+#define BUZZER_USE_TIMER0_ISR 1
+
+// Taster-Zeiten (ms)
+constexpr uint16_t BUTTON_DEBOUNCE_MS = 25;
+constexpr uint16_t BUTTON_LONG_MS     = 800;
+constexpr uint16_t BUTTON_REPEAT_MS   = 200;
 
 // I2C addresses
 constexpr uint8_t BME280_ADDR = 0x76;
 constexpr uint8_t GY271_ADDR  = 0x1E;
+constexpr uint8_t MPU9250_ADDR = 0x69;
+
+// Lesetakt der I2C-Sensoren in updateSensors()/updateNavigation() (ms).
+// Der BME280 liest bei jedem readHumidity()/readPressure() die Temperatur
+// mit, öfter als die Anzeige braucht lohnt sich das nicht.
+constexpr uint16_t ENV_READ_INTERVAL_MS = 1000;
+constexpr uint16_t IMU_READ_INTERVAL_MS = 20;        // 50 Hz (Data-Ready: 100 Hz)
+
+// IMU Data-Ready (INT-Pin des MPU9250), muss ein externer Interrupt sein
+constexpr uint8_t PIN_IMU_INT = 3;
+
+// IMU-Kalibrierung: liegt im Config-Store, autoOffsets() nur beim allerersten
+// Start oder auf Wunsch. Liegt das Gerät IMU_DRIFT_WINDOW_MS lang still
+// (Gyro schwankt weniger als IMU_STILL_GYRO_DPS, Betrag der Beschleunigung
+// nahe 1 g, Kurs bleibt innerhalb IMU_STILL_HEADING_DEG), wird der mittlere
+// Gyro-Wert ab IMU_GYRO_DRIFT_DPS als Drift in die Offsets übernommen.
+// Über IMU_GYRO_DRIFT_MAX_DPS ist es kein Offset-Fehler mehr, sondern eine
+// langsame Drehung, und es wird nichts übernommen.
+constexpr unsigned long IMU_DRIFT_WINDOW_MS = 20000;
+constexpr float IMU_STILL_GYRO_DPS = 1.0f;
+constexpr float IMU_STILL_ACC_G    = 0.03f;
+constexpr float IMU_GYRO_DRIFT_DPS = 0.3f;
+constexpr float IMU_GYRO_DRIFT_MAX_DPS = 3.0f;
+constexpr float IMU_STILL_HEADING_DEG  = 3.0f;
+
+// Magnetometer Hard-/Soft-Iron in Board-Achsen (µT), z. B. aus
+// tools/calibration_scripts/mag_fit. Gilt, bis die Online-Kalibrierung
+// einen eigenen Satz gespeichert hat; geänderte Werte hier ersetzen ihn.
+constexpr float MAG_CAL_OFFSET[3] = { 0.0f, 0.0f, 0.0f };
+constexpr float MAG_CAL_SCALE[3]  = { 1.0f, 1.0f, 1.0f };
+
+// Online-Kalibrierung (mag_calibrator.h): nur Messwerte bis zu dieser
+// Neigung, Fit nach einem Vollkreis mit mindestens MAG_CAL_MIN_SAMPLES
+// Werten, übernommen bei höchstens MAG_CAL_MAX_SPREAD_PCT Streuung und
+// mehr als MAG_CAL_MIN_CHANGE_UT Änderung (oder 1 % Skalierung)
+constexpr float    MAG_CAL_MAX_TILT_DEG   = 5.0f;
+constexpr float    MAG_CAL_LP             = 0.125f;
+constexpr uint16_t MAG_CAL_MIN_SAMPLES    = 500;
+constexpr uint8_t  MAG_CAL_MAX_SPREAD_PCT = 5;
+constexpr float    MAG_CAL_MIN_RADIUS_UT  = 5.0f;
+constexpr float    MAG_CAL_MIN_CHANGE_UT  = 0.5f;
+constexpr unsigned long MAG_CAL_SESSION_MS = 900000UL;   // 15 min
+
+// Knockdown-Schnellpfad: Krängung, ab der der ISR sofort Alarm gibt,
+// und wie viele Samples (à 10 ms) in Folge darüber liegen müssen
+constexpr float   KNOCKDOWN_HEEL_DEG = 60.0f;
+constexpr uint8_t KNOCKDOWN_SAMPLES  = 3;
+
+// GPS (NEO-6M an Serial1, Pins 18/19)
+constexpr unsigned long GPS_BAUD = 9600;
+constexpr unsigned long GPS_FIX_TIMEOUT_MS = 3000;   // ohne neues RMC gilt der Fix als verloren
+
+// RTC (DS3231): SQW-Ausgang (1 Hz, Open-Drain) an einen externen Interrupt
+constexpr uint8_t PIN_RTC_SQW = 2;
+constexpr unsigned long RTC_SQW_RESYNC_MS = 60UL * 60UL * 1000UL;   // DS3231 zur Kontrolle lesen
+
+// RTC (DS3231) gegen GPS-Zeit
+constexpr int32_t  RTC_MAX_ERROR_S      = 2;        // erst darüber wird der DS3231 neu gestellt
+constexpr uint32_t RTC_CHECK_INTERVAL_S = 600;      // DS3231 mit GPS vergleichen (s)
+constexpr uint32_t RTC_DRIFT_MIN_SPAN_S = 86400UL;  // Mindestspanne für eine Driftschätzung
+
+// SD-Logger (SPI des Mega: 50-52, CS 53; 10/11 sind Taster)
+constexpr uint8_t  PIN_SD_CS = 53;
+constexpr uint32_t LOG_PREALLOC_BLOCKS = 131072UL;   // 64 MB pro Datei
+constexpr uint16_t LOG_IMU_INTERVAL_MS = 50;          // 20 Hz
+constexpr uint16_t LOG_MAG_INTERVAL_MS = 1000;
+constexpr uint16_t LOG_ENV_INTERVAL_MS = 10000;
+constexpr uint32_t LOG_BAT_INTERVAL_MS = 60000UL;
+
+// 1 = Rohdaten von IMU, BME280, RTC und Tastern zusätzlich als Replay-Strom
+// loggen (input_recorder.h, Abspielen mit tools/sensor_replay)
+#ifndef RECORD_INPUTS
+#define RECORD_INPUTS 0
+#endif
 
 // Batterie
 constexpr int PIN_BATTERY_ADC = A0;
 constexpr float BATTERY_MAX_V = 4.2f;
 constexpr float BATTERY_MIN_V = 3.0f;
 
-
+// Display-Backend: 0 = SSD1306 OLED (128x64), 1 = HD44780 20x4 über PCF8574
+#define USE_LCD_2004 0
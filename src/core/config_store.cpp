@@ -0,0 +1,356 @@
+/*
+Rolle: Dauerhafte Einstellungen im EEPROM (Schlüssel/Wert, log-strukturiert).
+
+Inhalt:
+
+Seite:     Kopf { magic, gen, ~gen } + Datensätze + 0xFF (Ende)
+Datensatz: key, len, data[len], crc16 (CRC-CCITT, Startwert = gen)
+
+Weil die CRC mit der Generation der Seite beginnt, gelten übrig gebliebene
+Datensätze einer früheren Generation nicht (die Seite wird vor dem
+Verdichten nicht gelöscht).
+
+Verdichten: Datensätze auf die andere Seite kopieren, Ende-Byte, zuletzt
+den Kopf. Bis der Kopf steht, gilt die alte Seite weiter; fällt der
+Strom vorher aus, beginnt die Verdichtung beim nächsten Mal von vorn.
+
+Alle Schreibzugriffe laufen über einen Auftrag (Bytes + Adresse), von dem
+update() schreibt, solange eeprom_is_ready().
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <util/crc16.h>
+#include "config.h"
+#include "config_store.h"
+
+namespace {
+
+  constexpr uint16_t PAGE_MAGIC = 0xC5F1;
+  constexpr uint8_t  KEY_COUNT  = static_cast<uint8_t>(ConfigKey::COUNT);
+  constexpr uint8_t  END_MARK   = 0xFF;
+  constexpr uint8_t  RECORD_OVERHEAD = 4;             // key, len, crc16
+  constexpr uint8_t  PENDING_SLOTS   = KEY_COUNT - 1;   // ein Platz je Schlüssel, set() findet immer einen
+
+  struct PageHeader {
+    uint16_t magic;
+    uint16_t gen;
+    uint16_t check;     // ~gen
+  };
+
+  constexpr uint16_t HEADER_BYTES = sizeof(PageHeader);
+
+  enum class Phase : uint8_t { Idle, Append, Copy, EndMark, Header };
+
+  struct Pending {
+    uint8_t key;        // 0 = frei
+    uint8_t len;
+    uint8_t change;     // zählt bei jedem set(), millis() ist dafür zu grob
+    unsigned long since;
+    uint8_t data[CONFIG_MAX_VALUE];
+  };
+
+  int8_t   activePage = -1;                  // -1: noch nie geschrieben
+  uint16_t gen = 0;
+  uint16_t fill = 0;                         // erste freie Position in der aktiven Seite
+  uint16_t latest[KEY_COUNT];                // Offset des neuesten Datensatzes, 0 = keiner
+
+  Pending pending[PENDING_SLOTS];
+
+  uint8_t  job[CONFIG_MAX_VALUE + RECORD_OVERHEAD + 1];
+  uint8_t  jobLen = 0;
+  uint8_t  jobPos = 0;
+  int      jobAddr = 0;
+
+  Phase    phase = Phase::Idle;
+  uint8_t  appendSlot = 0;
+  uint8_t  appendChange = 0;
+  uint16_t appendOffset = 0;
+
+  int8_t   targetPage = 0;
+  uint16_t targetGen = 0;
+  uint16_t copyFill = 0;
+  uint8_t  copyKey = 0;
+  uint16_t newLatest[KEY_COUNT];
+  bool     justCompacted = false;             // seit dem Verdichten nichts angehängt
+
+  int pageAddr(int8_t page) {
+    return EEPROM_ADDR_CONFIG + page * EEPROM_CONFIG_PAGE_BYTES;
+  }
+
+  uint16_t recordCrc(uint16_t seed, uint8_t key, uint8_t len, const uint8_t* data) {
+    uint16_t crc = _crc_ccitt_update(seed, key);
+    crc = _crc_ccitt_update(crc, len);
+    for (uint8_t i = 0; i < len; ++i) crc = _crc_ccitt_update(crc, data[i]);
+    return crc;
+  }
+
+  // Datensatz an off prüfen; data darf nullptr sein (nur Länge/CRC)
+  bool readRecord(int8_t page, uint16_t off, uint16_t pageGen, uint8_t& key, uint8_t& len, uint8_t* data) {
+    if (off + RECORD_OVERHEAD > EEPROM_CONFIG_PAGE_BYTES) return false;
+    int addr = pageAddr(page) + off;
+    key = EEPROM.read(addr);
+    len = EEPROM.read(addr + 1);
+    if (key == 0 || key >= KEY_COUNT || len > CONFIG_MAX_VALUE) return false;
+    if (off + RECORD_OVERHEAD + len > EEPROM_CONFIG_PAGE_BYTES) return false;
+
+    uint16_t crc = _crc_ccitt_update(pageGen, key);
+    crc = _crc_ccitt_update(crc, len);
+    for (uint8_t i = 0; i < len; ++i) {
+      uint8_t b = EEPROM.read(addr + 2 + i);
+      if (data) data[i] = b;
+      crc = _crc_ccitt_update(crc, b);
+    }
+    uint16_t stored = EEPROM.read(addr + 2 + len) | (EEPROM.read(addr + 3 + len) << 8);
+    return crc == stored;
+  }
+
+  bool readHeader(int8_t page, uint16_t& pageGen) {
+    PageHeader h;
+    EEPROM.get(pageAddr(page), h);
+    if (h.magic != PAGE_MAGIC || h.check != (uint16_t)~h.gen) return false;
+    pageGen = h.gen;
+    return true;
+  }
+
+  // Datensätze bis zum ersten ungültigen (Ende-Byte, abgerissener Satz)
+  uint16_t scanPage(int8_t page, uint16_t pageGen, uint16_t* idx) {
+    for (uint8_t k = 0; k < KEY_COUNT; ++k) idx[k] = 0;
+    uint16_t off = HEADER_BYTES;
+    uint8_t key, len;
+    while (readRecord(page, off, pageGen, key, len, nullptr)) {
+      idx[key] = off;
+      off += RECORD_OVERHEAD + len;
+    }
+    return off;
+  }
+
+  uint8_t buildRecord(uint16_t seed, uint8_t key, uint8_t len, const uint8_t* data) {
+    job[0] = key;
+    job[1] = len;
+    memcpy(job + 2, data, len);
+    uint16_t crc = recordCrc(seed, key, len, data);
+    job[2 + len] = crc & 0xFF;
+    job[3 + len] = crc >> 8;
+    return RECORD_OVERHEAD + len;
+  }
+
+  // true, wenn der Auftrag fertig ist
+  bool writeStep() {
+    while (jobPos < jobLen) {
+      if (!eeprom_is_ready()) return false;
+      EEPROM.update(jobAddr + jobPos, job[jobPos]);   // unveränderte Bytes kosten nichts
+      jobPos++;
+    }
+    return true;
+  }
+
+  void startJob(int addr, uint8_t len) {
+    jobAddr = addr;
+    jobLen = len;
+    jobPos = 0;
+  }
+
+  int8_t findPending(uint8_t key) {
+    for (uint8_t i = 0; i < PENDING_SLOTS; ++i) {
+      if (pending[i].key == key) return i;
+    }
+    return -1;
+  }
+
+  void startCompaction() {
+    targetPage = activePage < 0 ? 0 : 1 - activePage;
+    targetGen = gen + 1;
+    copyFill = HEADER_BYTES;
+    copyKey = 1;
+    for (uint8_t k = 0; k < KEY_COUNT; ++k) newLatest[k] = 0;
+    phase = Phase::Copy;
+  }
+
+  // Nächsten Schritt der Verdichtung als Auftrag anlegen
+  void stepCompaction() {
+    uint8_t data[CONFIG_MAX_VALUE];
+    uint8_t key, len;
+
+    switch (phase) {
+      case Phase::Copy:
+        while (copyKey < KEY_COUNT) {
+          uint8_t k = copyKey++;
+          if (activePage < 0 || latest[k] == 0) continue;
+          if (!readRecord(activePage, latest[k], gen, key, len, data)) continue;
+          newLatest[k] = copyFill;
+          startJob(pageAddr(targetPage) + copyFill, buildRecord(targetGen, key, len, data));
+          copyFill += RECORD_OVERHEAD + len;
+          return;
+        }
+        phase = Phase::EndMark;
+        job[0] = END_MARK;
+        startJob(pageAddr(targetPage) + copyFill, copyFill < EEPROM_CONFIG_PAGE_BYTES ? 1 : 0);
+        return;
+
+      case Phase::EndMark: {
+        phase = Phase::Header;
+        PageHeader h = { PAGE_MAGIC, targetGen, (uint16_t)~targetGen };
+        memcpy(job, &h, sizeof(h));
+        startJob(pageAddr(targetPage), sizeof(h));
+        return;
+      }
+
+      case Phase::Header:
+        activePage = targetPage;
+        gen = targetGen;
+        fill = copyFill;
+        memcpy(latest, newLatest, sizeof(latest));
+        justCompacted = true;
+        phase = Phase::Idle;
+        return;
+
+      default:
+        return;
+    }
+  }
+
+  void finishAppend() {
+    Pending& p = pending[appendSlot];
+    latest[p.key] = appendOffset;
+    fill = appendOffset + RECORD_OVERHEAD + p.len;
+    // während des Schreibens erneut geändert -> bleibt vorgemerkt
+    if (p.change == appendChange) p.key = 0;
+    justCompacted = false;
+    phase = Phase::Idle;
+  }
+
+  void startNext() {
+    unsigned long now = millis();
+    int8_t due = -1;
+    for (uint8_t i = 0; i < PENDING_SLOTS; ++i) {
+      if (pending[i].key == 0 || now - pending[i].since < CONFIG_COALESCE_MS) continue;
+      if (due < 0 || (long)(pending[i].since - pending[due].since) < 0) due = i;
+    }
+
+    if (due < 0) {
+      // Leerlauf: rechtzeitig verdichten, bevor ein set() warten muss
+      if (activePage >= 0 && !justCompacted && fill > EEPROM_CONFIG_PAGE_BYTES * 3 / 4) startCompaction();
+      return;
+    }
+
+    Pending& p = pending[due];
+    uint16_t need = RECORD_OVERHEAD + p.len + 1;          // + Ende-Byte
+    if (activePage < 0 || fill + need > EEPROM_CONFIG_PAGE_BYTES) {
+      if (justCompacted) {
+        p.key = 0;                                        // passt auch nach dem Verdichten nicht
+        return;
+      }
+      startCompaction();
+      return;
+    }
+
+    appendSlot = due;
+    appendChange = p.change;
+    appendOffset = fill;
+    uint8_t n = buildRecord(gen, p.key, p.len, p.data);
+    if (fill + n < EEPROM_CONFIG_PAGE_BYTES) job[n++] = END_MARK;
+    startJob(pageAddr(activePage) + fill, n);
+    phase = Phase::Append;
+  }
+
+}
+
+namespace ConfigStore {
+
+  void begin() {
+    uint16_t g0 = 0, g1 = 0;
+    bool v0 = readHeader(0, g0);
+    bool v1 = readHeader(1, g1);
+
+    activePage = -1;
+    if (v0 && v1) {
+      activePage = (int16_t)(g1 - g0) > 0 ? 1 : 0;
+    } else if (v0 || v1) {
+      activePage = v0 ? 0 : 1;
+    }
+
+    if (activePage >= 0) {
+      gen = activePage == 0 ? g0 : g1;
+      fill = scanPage(activePage, gen, latest);
+    } else {
+      gen = 0;
+      fill = 0;
+      for (uint8_t k = 0; k < KEY_COUNT; ++k) latest[k] = 0;
+    }
+
+    for (uint8_t i = 0; i < PENDING_SLOTS; ++i) pending[i].key = 0;
+    jobLen = 0;
+    phase = Phase::Idle;
+  }
+
+  void update() {
+    if (jobLen > 0) {
+      if (!writeStep()) return;
+      jobLen = 0;
+      if (phase == Phase::Append) {
+        finishAppend();
+        return;
+      }
+    }
+    if (phase == Phase::Idle) {
+      startNext();
+    } else {
+      stepCompaction();
+    }
+  }
+
+  bool get(ConfigKey key, void* data, uint8_t len) {
+    uint8_t k = static_cast<uint8_t>(key);
+    if (k == 0 || k >= KEY_COUNT) return false;
+
+    int8_t p = findPending(k);
+    if (p >= 0) {
+      if (pending[p].len != len) return false;
+      memcpy(data, pending[p].data, len);
+      return true;
+    }
+
+    if (activePage < 0 || latest[k] == 0) return false;
+    uint8_t buf[CONFIG_MAX_VALUE];
+    uint8_t rk, rl;
+    if (!readRecord(activePage, latest[k], gen, rk, rl, buf) || rl != len) return false;
+    memcpy(data, buf, len);
+    return true;
+  }
+
+  bool set(ConfigKey key, const void* data, uint8_t len) {
+    uint8_t k = static_cast<uint8_t>(key);
+    if (k == 0 || k >= KEY_COUNT || len > CONFIG_MAX_VALUE) return false;
+
+    int8_t p = findPending(k);
+    if (p < 0) {
+      // unverändert gegenüber dem EEPROM -> nichts zu tun
+      uint8_t buf[CONFIG_MAX_VALUE];
+      uint8_t rk, rl;
+      if (activePage >= 0 && latest[k] != 0 && readRecord(activePage, latest[k], gen, rk, rl, buf)
+          && rl == len && memcmp(buf, data, len) == 0) {
+        return true;
+      }
+      p = findPending(0);
+      if (p < 0) return false;
+    }
+
+    Pending& e = pending[p];
+    e.change = e.key == k ? e.change + 1 : 0;
+    e.key = k;
+    e.len = len;
+    e.since = millis();
+    memcpy(e.data, data, len);
+    return true;
+  }
+
+  bool isIdle() {
+    if (jobLen > 0 || phase != Phase::Idle) return false;
+    for (uint8_t i = 0; i < PENDING_SLOTS; ++i) {
+      if (pending[i].key != 0) return false;
+    }
+    return true;
+  }
+
+}
@@ -0,0 +1,49 @@
+/*
+Rolle: Dauerhafte Einstellungen im EEPROM (Schlüssel/Wert, log-strukturiert).
+
+Inhalt:
+
+Zwei Seiten à EEPROM_CONFIG_PAGE_BYTES. Die aktive Seite wird nur
+angehängt: jeder set() erzeugt einen neuen Datensatz hinter dem letzten,
+alte Werte bleiben liegen -> die Schreibzugriffe wandern über die Seite
+statt immer dieselben Zellen zu treffen.
+
+Ist die Seite voll (oder zu drei Vierteln, wenn sonst nichts zu tun ist),
+kopiert update() die jeweils neuesten Werte auf die andere Seite und
+schaltet um (Generation + 1).
+
+Jeder Datensatz hat eine CRC-16; beim Laden zählt nur, was gültig ist.
+Ein halb geschriebener Datensatz wird ignoriert, der alte Wert gilt.
+
+set() schreibt nicht sofort: Änderungen am selben Schlüssel innerhalb von
+CONFIG_COALESCE_MS werden zu einem Schreibvorgang zusammengefasst
+(z. B. Wert im Settings-Screen mehrfach hochgezählt).
+
+update() schreibt höchstens so lange, wie der EEPROM bereit ist
+(ein Byte pro ~3,4 ms), loop() wartet also nie.
+*/
+
+#pragma once
+#include <stdint.h>
+
+enum class ConfigKey : uint8_t {
+  AlarmRules = 1,
+  ImuOffsets,
+  MagCalibration,
+  I2cDevices,
+  COUNT
+};
+
+constexpr uint8_t CONFIG_MAX_VALUE = 48;
+
+namespace ConfigStore {
+  void begin();                // aktive Seite suchen, Index aufbauen
+  void update();               // fällige Werte schreiben, Verdichtung (jede loop()-Runde)
+
+  // false = kein gültiger Wert dieser Länge vorhanden
+  bool get(ConfigKey key, void* data, uint8_t len);
+  // false = Wert zu groß (jeder Schlüssel hat einen eigenen Vormerkplatz)
+  bool set(ConfigKey key, const void* data, uint8_t len);
+
+  bool isIdle();               // nichts vorgemerkt, kein Schreibauftrag offen
+}
@@ -0,0 +1,170 @@
+/*
+Rolle: Zentraler Datenspeicher (Publish/Subscribe) für Messwerte.
+
+Inhalt:
+
+Quantisierung der Rohwerte auf Anzeigeauflösung
+
+Sequenznummern pro Kanal + globale Sequenznummer
+
+Kleine Hysterese, damit ein Wert genau auf der Rundungsgrenze
+nicht bei jedem Update hin- und herspringt
+*/
+
+#include <Arduino.h>
+#include "data_store.h"
+
+namespace {
+
+  constexpr uint8_t CHANNEL_COUNT = static_cast<uint8_t>(Channel::COUNT);
+
+  // Skalierung Rohwert -> quantisierter Wert, Reihenfolge wie enum Channel
+  const float SCALE[CHANNEL_COUNT] = {
+    10.0f,    // Temperature
+    10.0f,    // Humidity
+    10.0f,    // Pressure
+    10.0f,    // Roll
+    10.0f,    // Pitch
+    1.0f,     // Yaw
+    100.0f,   // BatteryVoltage
+    1.0f,     // BatteryPercent
+    10.0f     // PressureTrend
+  };
+
+  // Ein neuer Wert wird erst übernommen, wenn er mehr als
+  // 0,5 + DEADBAND Quantisierungsschritte vom alten entfernt ist.
+  constexpr float DEADBAND = 0.1f;
+
+  struct ChannelState {
+    int16_t  raw;
+    uint16_t seq;
+    bool     valid;
+  };
+
+  ChannelState channels[CHANNEL_COUNT];
+  uint16_t globalSeq = 0;
+
+  int16_t clampToInt16(float v) {
+    if (v < -32768.0f) return -32768;
+    if (v >  32767.0f) return  32767;
+    return (int16_t)lroundf(v);
+  }
+
+  void publish(Channel ch, float value) {
+    uint8_t i = static_cast<uint8_t>(ch);
+    ChannelState& s = channels[i];
+    float scaled = value * SCALE[i];
+
+    if (s.valid) {
+      float diff = scaled - s.raw;
+      if (ch == Channel::Yaw) {
+        // 359° -> 0° ist nur ein Grad Unterschied
+        if (diff >  180.0f) diff -= 360.0f;
+        if (diff < -180.0f) diff += 360.0f;
+      }
+      if (fabsf(diff) < 0.5f + DEADBAND) return;
+    }
+
+    int16_t q = clampToInt16(scaled);
+    if (ch == Channel::Yaw) {
+      q %= 360;
+      if (q < 0) q += 360;
+    }
+    if (s.valid && q == s.raw) return;
+
+    s.raw = q;
+    s.valid = true;
+    s.seq++;
+    globalSeq++;
+  }
+
+}
+
+namespace DataStore {
+
+  void begin() {
+    for (uint8_t i = 0; i < CHANNEL_COUNT; ++i) {
+      channels[i].raw = 0;
+      channels[i].seq = 0;
+      channels[i].valid = false;
+    }
+    globalSeq = 0;
+  }
+
+  void publishEnv(const EnvData& env) {
+    publish(Channel::Temperature, env.temperature);
+    publish(Channel::Humidity,    env.humidity);
+    publish(Channel::Pressure,    env.pressure);
+  }
+
+  void publishIMU(const IMUData& imu) {
+    publish(Channel::Roll,  imu.roll);
+    publish(Channel::Pitch, imu.pitch);
+    publish(Channel::Yaw,   imu.yaw);
+  }
+
+  void publishBattery(const BatteryStatus& bat) {
+    publish(Channel::BatteryVoltage, bat.voltage);
+    publish(Channel::BatteryPercent, bat.percentage);
+  }
+
+  void publishPressureTrend(float hpaPer3h) {
+    publish(Channel::PressureTrend, hpaPer3h);
+  }
+
+  int16_t getRaw(Channel ch) {
+    return channels[static_cast<uint8_t>(ch)].raw;
+  }
+
+  float getValue(Channel ch) {
+    return rawToValue(ch, getRaw(ch));
+  }
+
+  float rawToValue(Channel ch, int16_t raw) {
+    return raw / SCALE[static_cast<uint8_t>(ch)];
+  }
+
+  uint16_t getSeq(Channel ch) {
+    return channels[static_cast<uint8_t>(ch)].seq;
+  }
+
+  bool isValid(Channel ch) {
+    return channels[static_cast<uint8_t>(ch)].valid;
+  }
+
+  uint16_t getGlobalSeq() {
+    return globalSeq;
+  }
+
+  bool changed(Channel ch, uint16_t& lastSeen) {
+    uint16_t seq = getSeq(ch);
+    if (seq == lastSeen) return false;
+    lastSeen = seq;
+    return true;
+  }
+
+  EnvData getEnvData() {
+    EnvData env;
+    env.temperature = getValue(Channel::Temperature);
+    env.humidity    = getValue(Channel::Humidity);
+    env.pressure    = getValue(Channel::Pressure);
+    return env;
+  }
+
+  IMUData getIMU() {
+    // magX/Y/Z werden nicht quantisiert verteilt (nur Rohdaten für die Fusion)
+    IMUData imu = {};
+    imu.roll  = getValue(Channel::Roll);
+    imu.pitch = getValue(Channel::Pitch);
+    imu.yaw   = getValue(Channel::Yaw);
+    return imu;
+  }
+
+  BatteryStatus getBattery() {
+    BatteryStatus bat;
+    bat.voltage    = getValue(Channel::BatteryVoltage);
+    bat.percentage = getValue(Channel::BatteryPercent);
+    return bat;
+  }
+
+}
@@ -0,0 +1,56 @@
+/*
+Rolle: Zentraler Datenspeicher (Publish/Subscribe) für Messwerte.
+
+Inhalt:
+
+Ein Kanal pro Messgröße (aus EnvData, IMUData, BatteryStatus)
+
+Jeder Kanal hält einen quantisierten Wert (Auflösung = Anzeigeauflösung)
+und eine Sequenznummer, die nur bei einer Änderung des quantisierten
+Werts hochgezählt wird
+
+Verbraucher (Display, Alarme, Logger) merken sich die zuletzt gesehene
+Sequenznummer und überspringen ihre Arbeit, solange sich nichts ändert
+*/
+
+#pragma once
+#include <stdint.h>
+#include "types.h"
+
+enum class Channel : uint8_t {
+  Temperature,      // 0,1 °C
+  Humidity,         // 0,1 %
+  Pressure,         // 0,1 hPa
+  Roll,             // 0,1 °
+  Pitch,            // 0,1 °
+  Yaw,              // 1 °
+  BatteryVoltage,   // 0,01 V
+  BatteryPercent,   // 1 %
+  PressureTrend,    // 0,1 hPa / 3 h (Luftdrucktendenz)
+  COUNT
+};
+
+namespace DataStore {
+  void begin();
+
+  // Schreibseite: wird von updateSensors()/updateNavigation() aufgerufen
+  void publishEnv(const EnvData& env);
+  void publishIMU(const IMUData& imu);
+  void publishBattery(const BatteryStatus& bat);
+  void publishPressureTrend(float hpaPer3h);
+
+  // Leseseite
+  int16_t  getRaw(Channel ch);      // quantisierter Wert (Einheit siehe enum)
+  float    getValue(Channel ch);    // quantisierter Wert in physikalischer Einheit
+  float    rawToValue(Channel ch, int16_t raw);
+  uint16_t getSeq(Channel ch);      // läuft über, 0 heißt nicht "leer"
+  bool     isValid(Channel ch);     // schon einmal veröffentlicht
+  uint16_t getGlobalSeq();          // zählt bei jeder Änderung irgendeines Kanals
+
+  // true, wenn sich der Kanal seit lastSeen geändert hat; lastSeen wird nachgezogen
+  bool changed(Channel ch, uint16_t& lastSeen);
+
+  EnvData       getEnvData();
+  IMUData       getIMU();
+  BatteryStatus getBattery();
+}
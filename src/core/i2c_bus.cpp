@@ -0,0 +1,139 @@
+/*
+Rolle: Belegung des I²C-Busses zwischen Hauptprogramm und ISR, Geräte-Tabelle.
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "config.h"
+#include "config_store.h"
+#include "i2c_bus.h"
+
+namespace {
+  volatile bool locked = false;
+  void (* volatile deferred)() = nullptr;
+
+  constexpr uint8_t DEVICE_COUNT = static_cast<uint8_t>(I2CDevice::COUNT);
+
+  struct DeviceTable {
+    uint8_t addr[DEVICE_COUNT];
+  };
+
+  // Kandidaten in Suchreihenfolge; idMask == 0: ACK genügt
+  struct DeviceProbe {
+    const uint8_t* addrs;
+    uint8_t count;
+    uint8_t idReg;
+    uint8_t idMask;
+    uint8_t idValue;
+  };
+
+  // AD0 bzw. SDO wählt die Adresse; 0x68 ist auf dem Board vom DS3231 belegt
+  const uint8_t IMU_ADDRS[] = { MPU9250_ADDR, MPU9250_ADDR ^ 1 };
+  const uint8_t BME_ADDRS[] = { BME280_ADDR, BME280_ADDR ^ 1 };
+  const uint8_t RTC_ADDRS[] = { 0x68 };
+  // PCF8574 und PCF8574A, gängigste zuerst
+  const uint8_t LCD_ADDRS[] = { 0x27, 0x3F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26,
+                                0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E };
+
+  // Reihenfolge = Enum; Geräte mit ID-Register zuerst, damit das RTC
+  // nur eine Adresse bekommt, die kein MPU ist
+  const DeviceProbe PROBES[DEVICE_COUNT] = {
+    { IMU_ADDRS, sizeof(IMU_ADDRS), 0x75, 0xFC, 0x70 },   // WHO_AM_I: MPU6500 0x70, MPU9250 0x71, 9255 0x73
+    { BME_ADDRS, sizeof(BME_ADDRS), 0xD0, 0xFF, 0x60 },   // chip_id BME280
+    { RTC_ADDRS, sizeof(RTC_ADDRS), 0, 0, 0 },
+    { LCD_ADDRS, sizeof(LCD_ADDRS), 0, 0, 0 },
+  };
+
+  DeviceTable table = { { MPU9250_ADDR, BME280_ADDR, 0x68, I2C_NO_DEVICE } };
+
+  bool deviceUsed(I2CDevice device) {
+#if !USE_LCD_2004
+    if (device == I2CDevice::Lcd) return false;
+#endif
+    return true;
+  }
+
+  bool readRegister(uint8_t addr, uint8_t reg, uint8_t& value) {
+    Wire.beginTransmission(addr);
+    Wire.write(reg);
+    if (Wire.endTransmission(false) != 0) return false;
+    if (Wire.requestFrom(addr, (uint8_t)1) != 1) return false;
+    value = Wire.read();
+    return true;
+  }
+
+  bool matches(const DeviceProbe& probe, uint8_t addr) {
+    Wire.beginTransmission(addr);
+    if (Wire.endTransmission() != 0) return false;
+    if (probe.idMask == 0) return true;
+    uint8_t id;
+    return readRegister(addr, probe.idReg, id) && (id & probe.idMask) == probe.idValue;
+  }
+
+  // schon einem früheren Gerät zugeordnet?
+  bool taken(uint8_t addr, uint8_t before) {
+    for (uint8_t i = 0; i < before; ++i) {
+      if (table.addr[i] == addr) return true;
+    }
+    return false;
+  }
+}
+
+namespace I2CBus {
+
+  void lock() {
+    locked = true;
+  }
+
+  void unlock() {
+    noInterrupts();
+    void (*callback)() = deferred;
+    deferred = nullptr;
+    locked = false;
+    interrupts();
+
+    if (callback) callback();
+  }
+
+  bool isLocked() {
+    return locked;
+  }
+
+  void deferUntilUnlock(void (*callback)()) {
+    deferred = callback;
+  }
+
+  void discover() {
+    DeviceTable cached;
+    bool haveCache = ConfigStore::get(ConfigKey::I2cDevices, &cached, sizeof(cached));
+
+    for (uint8_t d = 0; d < DEVICE_COUNT; ++d) {
+      const DeviceProbe& probe = PROBES[d];
+      uint8_t found = I2C_NO_DEVICE;
+      if (deviceUsed(static_cast<I2CDevice>(d))) {
+        uint8_t last = haveCache ? cached.addr[d] : I2C_NO_DEVICE;
+        if (last != I2C_NO_DEVICE && !taken(last, d) && matches(probe, last)) {
+          found = last;
+        } else {
+          for (uint8_t i = 0; i < probe.count; ++i) {
+            uint8_t addr = probe.addrs[i];
+            if (addr != last && !taken(addr, d) && matches(probe, addr)) {
+              found = addr;
+              break;
+            }
+          }
+        }
+      }
+      table.addr[d] = found;
+    }
+
+    if (!haveCache || memcmp(&cached, &table, sizeof(table)) != 0) {
+      ConfigStore::set(ConfigKey::I2cDevices, &table, sizeof(table));
+    }
+  }
+
+  uint8_t address(I2CDevice device) {
+    return table.addr[static_cast<uint8_t>(device)];
+  }
+
+}
@@ -0,0 +1,46 @@
+/*
+Rolle: Belegung des I²C-Busses zwischen Hauptprogramm und ISR, Geräte-Tabelle.
+
+Inhalt:
+
+Hauptprogramm-Module klammern ihre Wire-Transaktionen mit lock()/unlock()
+
+Ein ISR, der selbst auf den Bus will (Knockdown-Schnellpfad), prüft
+isLocked(); ist der Bus belegt, meldet er sich mit deferUntilUnlock()
+und wird direkt beim unlock() nachgeholt
+
+Geräte-Tabelle: discover() prüft beim Start (nach Wire.begin() und
+ConfigStore::begin(), vor den Treibern) die möglichen Adressen jedes
+Geräts wie examples/i2c_scanner.cpp (ACK), bei MPU und BME zusätzlich
+das ID-Register, damit z. B. DS3231 und MPU auf 0x68 nicht verwechselt
+werden. Die Treiber holen ihre Adresse mit address().
+
+Das Ergebnis liegt im Config-Store: beim nächsten Start wird zuerst nur
+die gespeicherte Adresse geprüft, die übrigen Kandidaten erst, wenn dort
+nichts antwortet. Fehlende Geräte werden gar nicht erst initialisiert.
+*/
+
+#pragma once
+#include <stdint.h>
+
+enum class I2CDevice : uint8_t {
+  Imu,
+  Bme,
+  Rtc,
+  Lcd,
+  COUNT
+};
+
+constexpr uint8_t I2C_NO_DEVICE = 0;
+
+namespace I2CBus {
+  void lock();
+  void unlock();
+  bool isLocked();
+  // Aus ISR: Callback beim nächsten unlock() (im Hauptprogramm-Kontext) ausführen
+  void deferUntilUnlock(void (*callback)());
+
+  void discover();
+  // I2C_NO_DEVICE = nicht gefunden; ohne discover() die Adressen aus config.h
+  uint8_t address(I2CDevice device);
+}
@@ -16,16 +16,41 @@ Nutzt die öffentlichen Schnittstellen der anderen Module, aber enthält keine S
 #include "menu_system.h"
 #include "display.h"
 #include "buttons.h"
+#include "data_store.h"
+#include "buzzer.h"
+#include "rtc_module.h"
+
+// Neu gerendert wird nur, wenn sich ein Kanal (in Anzeigeauflösung),
+// der Screen oder der UI-Zustand (Regel-Editor) geändert hat. Die Uhr
+// läuft ohne Datenkanal und wird beim Sekundenwechsel gezeichnet.
+uint16_t last_render_seq = 0;
+uint16_t last_render_ui = 0;
+ScreenId last_render_screen = ScreenId::ENV;
+bool first_render = true;
 
 void setup() {
   systemInit();
 }
 
 void loop() {
-  updateButtons();
+  Buttons::update();
+  Buzzer::update();
   updateSensors();
   updateNavigation();
-  updateMenuSystem();
-  renderDisplay();
+  MenuSystem::update();
+
+  uint16_t seq = DataStore::getGlobalSeq();
+  ScreenId screen = MenuSystem::getCurrentScreen();
+  uint16_t ui = MenuSystem::getUiSeq();
+  if (first_render || seq != last_render_seq || screen != last_render_screen || ui != last_render_ui
+      || (screen == ScreenId::CLOCK && (RTCModule::getChanges() & TIME_CHANGED_SECOND))) {
+    renderDisplay();
+    last_render_seq = seq;
+    last_render_screen = screen;
+    last_render_ui = ui;
+    first_render = false;
+  }
+
   handleAlarms();
+  updateLogging();
 }
@@ -22,17 +22,127 @@ Buzzer
 globale Zustandsobjekte
 */
 
-#include "mpu9250_module.h"
+#include <Wire.h>
+#include "mpu9250_sensor.h"
+#include "config.h"
 #include "display_oled.h"
+#include "display_lcd.h"
 #include "battery_monitor.h"
 #include "rtc_module.h"
 #include "buttons.h"
+#include "buzzer.h"
+#include "bme280_sensor.h"
+#include "data_store.h"
+#include "gps_module.h"
+#include "alarms.h"
+#include "knockdown.h"
+#include "menu_system.h"
+#include "sd_logger.h"
+#include "input_recorder.h"
+#include "history_store.h"
+#include "config_store.h"
+#include "i2c_bus.h"
 
 void systemInit() {
+    // zuerst: Alarmregeln und IMU-Kalibrierung kommen aus dem Config-Store
+    ConfigStore::begin();
     Wire.begin();
+    // Geräte-Tabelle vor allen I2C-Treibern
+    I2CBus::discover();
     Buttons::begin();
+    Buzzer::begin();
+#if USE_LCD_2004
+    DisplayLCD::begin();
+#else
     DisplayOLED::begin();
+#endif
     RTCModule::begin();
     BatteryMonitor::begin();
     MPU9250Module::begin();
+    BME280Sensor::begin();
+    GPSModule::begin();
+    DataStore::begin();
+    Alarms::begin();
+    MenuSystem::begin();
+    SDLogger::begin();
+    History::begin();
+    // zuletzt: ab hier liest der IMU-ISR selbst über I2C
+    MPU9250Module::startDataReady();
+}
+
+void updateSensors() {
+    RTCModule::update();
+    BatteryMonitor::update();
+    DataStore::publishBattery(BatteryMonitor::getStatus());
+
+    // BME280 nur im eigenen Takt über I2C lesen; ohne Sensor bleiben die
+    // Kanäle unveröffentlicht (Alarme und Verlauf ignorieren sie dann)
+    static uint32_t lastEnv = 0;
+    static bool envRead = false;
+    uint32_t now = millis();
+    if (BME280Sensor::isPresent() && (!envRead || now - lastEnv >= ENV_READ_INTERVAL_MS)) {
+        lastEnv = now;
+        envRead = true;
+        BME280Sensor::update();
+        DataStore::publishEnv(BME280Sensor::getEnvData());
+        if (BME280Sensor::hasPressureTrend()) {
+            DataStore::publishPressureTrend(BME280Sensor::getPressureTrend());
+        }
+    }
+    History::update();
+}
+
+void updateNavigation() {
+    GPSModule::update();
+    // neues gültiges RMC -> Uhr nachführen
+    static uint32_t lastFix = 0;
+    if (GPSModule::lastFixMs() != lastFix) {
+        lastFix = GPSModule::lastFixMs();
+        RTCModule::discipline(GPSModule::getData(), lastFix);
+        SDLogger::logGPS(GPSModule::getData());
+    }
+
+    static uint32_t lastImu = 0;
+    uint32_t now = millis();
+    if (MPU9250Module::isPresent() && now - lastImu >= IMU_READ_INTERVAL_MS) {
+        lastImu = now;
+        MPU9250Module::update();
+        DataStore::publishIMU(MPU9250Module::getIMU());
+    }
+}
+
+void handleAlarms() {
+    InputRecorder::markLoop();
+    Knockdown::update();
+    Alarms::update();
+}
+
+
+void updateLogging() {
+    static uint32_t lastImu = 0, lastMag = 0, lastEnv = 0, lastBat = 0;
+    uint32_t now = millis();
+
+    bool imu = MPU9250Module::isPresent();
+    if (imu && now - lastImu >= LOG_IMU_INTERVAL_MS) {
+        lastImu = now;
+        SDLogger::logIMU(MPU9250Module::getIMU());
+    }
+    if (imu && now - lastMag >= LOG_MAG_INTERVAL_MS) {
+        lastMag = now;
+        SDLogger::logMag(MPU9250Module::getIMU());
+    }
+    if (BME280Sensor::isPresent() && now - lastEnv >= LOG_ENV_INTERVAL_MS) {
+        lastEnv = now;
+        SDLogger::logEnv(BME280Sensor::getEnvData());
+    }
+    if (now - lastBat >= LOG_BAT_INTERVAL_MS) {
+        lastBat = now;
+        SDLogger::logBattery(BatteryMonitor::getStatus());
+    }
+
+    // höchstens ein Sektor pro Runde, nur wenn die Karte frei ist
+    SDLogger::update();
+
+    // Config-Store: schreibt nur, solange der EEPROM bereit ist
+    ConfigStore::update();
 }
@@ -28,5 +28,6 @@ void systemInit();
 void updateSensors();
 void updateNavigation();
 void handleAlarms();
+void updateLogging();
 
 
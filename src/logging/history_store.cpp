@@ -0,0 +1,243 @@
+/*
+Rolle: Stündlicher Verlauf von Temperatur, Feuchte und Luftdruck im EEPROM.
+
+Inhalt:
+
+Slot = 10 Byte Kopf + 54 Byte Nutzdaten:
+  magic, count (Stunden), seq (steigt pro Slot), startHour, used (Bytes),
+  crc (CRC-8 über Kopf ohne crc + Nutzdaten)
+Nutzdaten pro Stunde: Temperatur, Feuchte, Druck als Zig-Zag-Varint,
+die erste Stunde absolut, jede weitere als Differenz zur Vorstunde.
+
+Neuer Slot, wenn der offene voll ist oder eine Stunde fehlt (Gerät aus);
+er ersetzt den ältesten im Ring.
+
+Schreibreihenfolge: erst die neuen Nutzbytes, dann der Kopf. Reißt der
+Strom dazwischen ab, passt die CRC nicht und nur dieser Slot fehlt.
+EEPROM.update() schreibt nur geänderte Bytes; der Kopf des offenen Slots
+wird einmal pro Stunde neu geschrieben.
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <util/crc16.h>
+#include "config.h"
+#include "data_store.h"
+#include "rtc_module.h"
+#include "history_store.h"
+
+namespace {
+
+  constexpr uint8_t HISTORY_MAGIC = 0xB7;
+
+#pragma pack(push, 1)
+  struct SlotHeader {
+    uint8_t  magic;
+    uint8_t  count;
+    uint16_t seq;
+    uint32_t startHour;
+    uint8_t  used;
+    uint8_t  crc;
+  };
+#pragma pack(pop)
+
+  constexpr uint8_t HEADER_BYTES  = sizeof(SlotHeader);
+  constexpr uint8_t PAYLOAD_BYTES = HISTORY_SLOT_BYTES - HEADER_BYTES;
+  constexpr uint16_t SLOT_COUNT   = EEPROM_HISTORY_BYTES / HISTORY_SLOT_BYTES;
+  constexpr uint8_t MAX_SAMPLE_BYTES = 9;             // 3 Werte zu höchstens 3 Byte
+
+  static_assert(HEADER_BYTES == 10, "SlotHeader muss 10 Byte haben");
+  static_assert(SLOT_COUNT >= 2, "EEPROM_HISTORY_BYTES zu klein");
+
+  // Offener (neuester) Slot als Kopie im RAM
+  uint8_t open[HISTORY_SLOT_BYTES];
+  int16_t openSlot = -1;
+  HistorySample last = {};
+
+  int slotAddress(uint16_t slot) {
+    return EEPROM_ADDR_HISTORY + slot * HISTORY_SLOT_BYTES;
+  }
+
+  SlotHeader& header(uint8_t* slot) {
+    return *reinterpret_cast<SlotHeader*>(slot);
+  }
+
+  uint8_t slotCrc(const uint8_t* slot) {
+    const SlotHeader& h = *reinterpret_cast<const SlotHeader*>(slot);
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < HEADER_BYTES - 1; ++i) crc = _crc8_ccitt_update(crc, slot[i]);
+    for (uint8_t i = 0; i < h.used; ++i) crc = _crc8_ccitt_update(crc, slot[HEADER_BYTES + i]);
+    return crc;
+  }
+
+  // Slot aus dem EEPROM nach buf, true wenn gültig
+  bool readSlot(uint16_t slot, uint8_t* buf) {
+    int addr = slotAddress(slot);
+    for (uint8_t i = 0; i < HEADER_BYTES; ++i) buf[i] = EEPROM.read(addr + i);
+    const SlotHeader& h = header(buf);
+    if (h.magic != HISTORY_MAGIC || h.count == 0 || h.used > PAYLOAD_BYTES) return false;
+    for (uint8_t i = 0; i < h.used; ++i) buf[HEADER_BYTES + i] = EEPROM.read(addr + HEADER_BYTES + i);
+    return slotCrc(buf) == h.crc;
+  }
+
+  uint8_t putVarint(uint8_t* p, int32_t v) {
+    uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);   // Zig-Zag: -1 -> 1, 1 -> 2
+    uint8_t n = 0;
+    while (z >= 0x80) {
+      p[n++] = (uint8_t)(z | 0x80);
+      z >>= 7;
+    }
+    p[n++] = (uint8_t)z;
+    return n;
+  }
+
+  int32_t getVarint(const uint8_t* p, uint8_t& pos) {
+    uint32_t z = 0;
+    uint8_t shift = 0;
+    uint8_t b;
+    do {
+      b = p[pos++];
+      z |= (uint32_t)(b & 0x7F) << shift;
+      shift += 7;
+    } while ((b & 0x80) && shift < 21);
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+  }
+
+  uint8_t encodeSample(uint8_t* p, const HistorySample& s, const HistorySample* prev) {
+    uint8_t n = 0;
+    n += putVarint(p + n, (int32_t)s.temperature - (prev ? prev->temperature : 0));
+    n += putVarint(p + n, (int32_t)s.humidity    - (prev ? prev->humidity    : 0));
+    n += putVarint(p + n, (int32_t)s.pressure    - (prev ? prev->pressure    : 0));
+    return n;
+  }
+
+  void decodeSample(const uint8_t* p, uint8_t& pos, HistorySample& s, bool absolute) {
+    int32_t t = getVarint(p, pos);
+    int32_t h = getVarint(p, pos);
+    int32_t q = getVarint(p, pos);
+    s.temperature = absolute ? t : s.temperature + t;
+    s.humidity    = absolute ? h : s.humidity + h;
+    s.pressure    = absolute ? q : s.pressure + q;
+  }
+
+  void writeOpen(uint8_t fromPayload) {
+    SlotHeader& h = header(open);
+    h.crc = slotCrc(open);
+    int addr = slotAddress(openSlot);
+    for (uint8_t i = fromPayload; i < h.used; ++i) {
+      EEPROM.update(addr + HEADER_BYTES + i, open[HEADER_BYTES + i]);
+    }
+    EEPROM.put(addr, h);
+  }
+
+}
+
+namespace History {
+
+  void begin() {
+    uint8_t buf[HISTORY_SLOT_BYTES];
+    openSlot = -1;
+    uint16_t bestSeq = 0;
+
+    for (uint16_t i = 0; i < SLOT_COUNT; ++i) {
+      if (!readSlot(i, buf)) continue;
+      uint16_t seq = header(buf).seq;
+      if (openSlot < 0 || seq > bestSeq) {
+        openSlot = i;
+        bestSeq = seq;
+        memcpy(open, buf, sizeof(open));
+      }
+    }
+    if (openSlot < 0) return;
+
+    // letzten Wert des offenen Slots für die nächste Differenz
+    const SlotHeader& h = header(open);
+    uint8_t pos = HEADER_BYTES;
+    for (uint8_t i = 0; i < h.count; ++i) decodeSample(open, pos, last, i == 0);
+    last.hour = h.startHour + h.count - 1;
+  }
+
+  void update() {
+    if (!(RTCModule::getChanges() & TIME_CHANGED_HOUR)) return;
+    if (!DataStore::isValid(Channel::Pressure)) return;   // noch kein BME-Wert
+
+    HistorySample s;
+    s.hour        = RTCModule::getUnixTime() / 3600UL;
+    s.temperature = DataStore::getRaw(Channel::Temperature);
+    s.humidity    = DataStore::getRaw(Channel::Humidity);
+    s.pressure    = DataStore::getRaw(Channel::Pressure);
+    append(s);
+  }
+
+  bool append(const HistorySample& s) {
+    if (openSlot >= 0 && s.hour <= last.hour) return false;   // gleiche Stunde oder Uhr zurückgestellt
+
+    uint8_t bytes[MAX_SAMPLE_BYTES];
+    SlotHeader& h = header(open);
+    bool extend = openSlot >= 0 && s.hour == last.hour + 1 && h.count < 255;
+    uint8_t n = extend ? encodeSample(bytes, s, &last) : 0;
+    if (extend && h.used + n <= PAYLOAD_BYTES) {
+      uint8_t from = h.used;
+      memcpy(open + HEADER_BYTES + h.used, bytes, n);
+      h.used += n;
+      h.count++;
+      writeOpen(from);
+    } else {
+      uint16_t seq = openSlot >= 0 ? h.seq + 1 : 0;
+      openSlot = openSlot >= 0 ? (openSlot + 1) % SLOT_COUNT : 0;
+      memset(open, 0xFF, sizeof(open));
+      h.magic = HISTORY_MAGIC;
+      h.count = 1;
+      h.seq = seq;
+      h.startHour = s.hour;
+      h.used = encodeSample(open + HEADER_BYTES, s, nullptr);
+      writeOpen(0);
+    }
+    last = s;
+    return true;
+  }
+
+  uint16_t getSlotCount() {
+    return SLOT_COUNT;
+  }
+
+  uint32_t getNewestHour() {
+    return openSlot >= 0 ? last.hour : 0;
+  }
+
+}
+
+HistoryReader::HistoryReader()
+  : slotsLeft(openSlot >= 0 ? SLOT_COUNT : 0),
+    slot(openSlot >= 0 ? (openSlot + 1) % SLOT_COUNT : 0),
+    pos(0),
+    hoursLeft(0),
+    cur() {}
+
+bool HistoryReader::loadSlot() {
+  while (slotsLeft > 0) {
+    uint16_t s = slot;
+    slot = (slot + 1) % SLOT_COUNT;
+    slotsLeft--;
+    if (!readSlot(s, buf)) continue;
+    const SlotHeader& h = header(buf);
+    pos = HEADER_BYTES;
+    hoursLeft = h.count;
+    cur.hour = h.startHour;
+    decodeSample(buf, pos, cur, true);
+    return true;
+  }
+  return false;
+}
+
+bool HistoryReader::next(HistorySample& out) {
+  if (hoursLeft == 0) {
+    if (!loadSlot()) return false;
+  } else {
+    cur.hour++;
+    decodeSample(buf, pos, cur, false);
+  }
+  hoursLeft--;
+  out = cur;
+  return true;
+}
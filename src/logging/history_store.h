@@ -0,0 +1,54 @@
+/*
+Rolle: Stündlicher Verlauf von Temperatur, Feuchte und Luftdruck im EEPROM
+(ohne SD-Karte).
+
+Inhalt:
+
+Werte in DataStore-Einheiten (0,1 °C, 0,1 %, 0,1 hPa), einmal pro Stunde
+beim Stundenwechsel der RTC
+
+Ring aus Slots fester Größe; ein Slot hält aufeinanderfolgende Stunden:
+erster Wert absolut, danach Differenz zur Vorstunde, beides als
+Zig-Zag-Varint (kleine Änderungen = 1 Byte). Typisch ca. 3 Byte pro
+Stunde -> einige Wochen in 3 KB, auch bei unruhigem Wetter > 7 Tage.
+
+Lesen: HistoryReader läuft vom ältesten zum neuesten Wert, Slot für Slot
+(ein Slot wird einmal gelesen und geprüft, danach nur noch dekodiert)
+*/
+
+#pragma once
+#include <stdint.h>
+
+struct HistorySample {
+  uint32_t hour;          // Unix-Zeit / 3600
+  int16_t  temperature;   // 0,1 °C
+  int16_t  humidity;      // 0,1 %
+  int16_t  pressure;      // 0,1 hPa
+};
+
+constexpr uint8_t HISTORY_SLOT_BYTES = 64;
+
+namespace History {
+  void begin();                     // sucht den neuesten Slot
+  void update();                    // aus updateSensors(): Stundenwert aus dem DataStore
+  bool append(const HistorySample& s);
+
+  uint16_t getSlotCount();
+  uint32_t getNewestHour();         // 0 = noch nichts gespeichert
+}
+
+class HistoryReader {
+public:
+  HistoryReader();
+  bool next(HistorySample& out);    // false = Ende
+
+private:
+  bool loadSlot();
+
+  uint16_t slotsLeft;
+  uint16_t slot;
+  uint8_t  buf[HISTORY_SLOT_BYTES];
+  uint8_t  pos;
+  uint8_t  hoursLeft;
+  HistorySample cur;
+};
@@ -0,0 +1,160 @@
+/*
+Rolle: Mitschnitt der Sensor-Rohdaten für das Abspielen auf dem PC.
+
+Inhalt:
+
+Einträge werden Byte für Byte in ein 10-Byte-Stück geschrieben; ist es
+voll, geht es als LogRecord an SDLogger::log()
+
+Knockdown-Samples kommen aus dem ISR: sie landen mit Zeitstempel in einem
+kleinen Ring und werden vor dem nächsten Eintrag aus dem Hauptprogramm
+in den Strom übernommen (der Strom selbst ist nicht ISR-fest)
+
+Solange SDLogger nicht schreibt, wird nichts aufgezeichnet; der nächste
+Eintrag trägt dann wieder eine absolute Zeit
+*/
+
+#include <Arduino.h>
+#include "config.h"
+
+#if RECORD_INPUTS
+
+#include "log_format.h"
+#include "replay_format.h"
+#include "sd_logger.h"
+#include "input_recorder.h"
+
+namespace {
+
+  uint8_t chunk[REPLAY_CHUNK_BYTES];
+  uint8_t chunkLen = 0;
+  uint8_t firstEntry = REPLAY_NO_ENTRY;
+
+  uint32_t lastMs = 0;
+  bool haveTime = false;
+  uint32_t lostChunks = 0;
+
+  struct KnockSample {
+    uint32_t ms;
+    int16_t  lateral;
+    int16_t  vertical;
+  };
+
+  constexpr uint8_t KNOCK_RING = 8;                 // 80 ms bei 100 Hz
+  volatile KnockSample knockRing[KNOCK_RING];
+  volatile uint8_t knockHead = 0;                   // schreibt der ISR
+  volatile uint8_t knockTail = 0;                   // liest das Hauptprogramm
+
+  void flushChunk() {
+    LogRecord r = {};
+    r.timeMs = millis();
+    r.type = static_cast<uint8_t>(LogType::Replay);
+    r.flags = replayChunkFlags(chunkLen, firstEntry);
+    memcpy(r.bytes, chunk, chunkLen);
+    if (!SDLogger::log(r)) lostChunks++;
+    chunkLen = 0;
+    firstEntry = REPLAY_NO_ENTRY;
+  }
+
+  void putByte(uint8_t b) {
+    chunk[chunkLen++] = b;
+    if (chunkLen == REPLAY_CHUNK_BYTES) flushChunk();
+  }
+
+  void put(const void* data, uint8_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (len--) putByte(*p++);
+  }
+
+  void beginEntry(ReplayTag tag, uint32_t ms) {
+    if (firstEntry == REPLAY_NO_ENTRY) firstEntry = chunkLen;
+    putByte(static_cast<uint8_t>(tag));
+
+    uint32_t dt = ms - lastMs;
+    if (!haveTime || dt >= REPLAY_DT_ABSOLUTE) {
+      putByte(REPLAY_DT_ABSOLUTE);
+      put(&ms, sizeof(ms));
+    } else {
+      putByte((uint8_t)dt);
+    }
+    lastMs = ms;
+    haveTime = true;
+  }
+
+  void drainKnock() {
+    while (knockTail != knockHead) {
+      noInterrupts();
+      KnockSample s;
+      s.ms       = knockRing[knockTail].ms;
+      s.lateral  = knockRing[knockTail].lateral;
+      s.vertical = knockRing[knockTail].vertical;
+      knockTail = (knockTail + 1) % KNOCK_RING;
+      interrupts();
+
+      beginEntry(ReplayTag::Knock, s.ms);
+      put(&s.lateral, sizeof(s.lateral));
+      put(&s.vertical, sizeof(s.vertical));
+    }
+  }
+
+  // false, solange nicht geloggt wird (Eintrag dann komplett auslassen)
+  bool begin(ReplayTag tag) {
+    if (!SDLogger::isLogging()) {
+      haveTime = false;
+      knockTail = knockHead;
+      return false;
+    }
+    drainKnock();
+    beginEntry(tag, millis());
+    return true;
+  }
+
+}
+
+namespace InputRecorder {
+
+  void recordImu(float ax, float ay, float az, float mx, float my, float mz) {
+    if (!begin(ReplayTag::Imu)) return;
+    const float v[6] = { ax, ay, az, mx, my, mz };
+    put(v, sizeof(v));
+  }
+
+  void recordKnock(int16_t lateral, int16_t vertical) {
+    uint8_t next = (knockHead + 1) % KNOCK_RING;
+    if (next == knockTail) return;                  // Ring voll: Sample fehlt im Strom
+    knockRing[knockHead].ms       = millis();
+    knockRing[knockHead].lateral  = lateral;
+    knockRing[knockHead].vertical = vertical;
+    knockHead = next;
+  }
+
+  void recordEnv(float temperature, float humidity, float pressurePa) {
+    if (!begin(ReplayTag::Env)) return;
+    const float v[3] = { temperature, humidity, pressurePa };
+    put(v, sizeof(v));
+  }
+
+  void recordClock(uint32_t epoch) {
+    if (!begin(ReplayTag::Clock)) return;
+    uint32_t ms = lastMs;
+    put(&epoch, sizeof(epoch));
+    put(&ms, sizeof(ms));
+  }
+
+  void recordButton(uint8_t buttonId, uint8_t type) {
+    if (!begin(ReplayTag::Button)) return;
+    putByte(buttonId);
+    putByte(type);
+  }
+
+  void markLoop() {
+    begin(ReplayTag::Loop);
+  }
+
+  uint32_t getLostChunks() {
+    return lostChunks;
+  }
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+Rolle: Mitschnitt der Sensor-Rohdaten für das Abspielen auf dem PC.
+
+Inhalt:
+
+Mit RECORD_INPUTS = 1 (config.h) legen die Module ihre Eingangswerte hier
+ab, bevor sie gerechnet werden: IMU (MPU9250_WE), Knockdown-Samples aus
+dem ISR, BME280, RTC-Sekunde und Taster-Events. Dazu eine Marke pro
+loop()-Runde, an der handleAlarms() läuft.
+
+Der Strom (replay_format.h) geht über SDLogger in die normale Logdatei;
+tools/sensor_replay spielt ihn durch dieselben Module.
+
+Mit RECORD_INPUTS = 0 sind alle Aufrufe leere Inline-Funktionen.
+*/
+
+#pragma once
+#include <stdint.h>
+#include "config.h"
+
+#if RECORD_INPUTS
+
+namespace InputRecorder {
+  void recordImu(float ax, float ay, float az, float mx, float my, float mz);
+  void recordKnock(int16_t lateral, int16_t vertical);   // ISR-fest
+  void recordEnv(float temperature, float humidity, float pressurePa);
+  void recordClock(uint32_t epoch);
+  void recordButton(uint8_t buttonId, uint8_t type);
+  void markLoop();
+
+  uint32_t getLostChunks();     // von SDLogger verworfene Stücke
+}
+
+#else
+
+namespace InputRecorder {
+  inline void recordImu(float, float, float, float, float, float) {}
+  inline void recordKnock(int16_t, int16_t) {}
+  inline void recordEnv(float, float, float) {}
+  inline void recordClock(uint32_t) {}
+  inline void recordButton(uint8_t, uint8_t) {}
+  inline void markLoop() {}
+
+  inline uint32_t getLostChunks() { return 0; }
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+Rolle: Binärformat der Logdateien (Gerät und PC-Tools).
+
+Inhalt:
+
+Datei = Folge von 512-Byte-Blöcken (= ein SD-Sektor)
+
+Block = 32 Byte Kopf + 30 Datensätze zu je 16 Byte
+
+Alle Werte little endian (AVR und x86), Strukturen gepackt
+
+Prüfsumme: CRC-16/CCITT wie _crc_ccitt_update() aus avr-libc
+(Startwert 0xFFFF) über die Datensätze des Blocks
+
+Dateikennung: fileNumber + fileEpoch stehen in jedem Block. Nach einem
+Stromausfall bleibt die Datei vorreserviert, im ungeschriebenen Rest
+können gültige Blöcke einer gelöschten älteren Datei liegen (seq fängt
+überall bei 0 an). Leser hören beim ersten Block mit anderer Kennung auf.
+Dateien vor dieser Kennung haben dort 0.
+
+Keine Arduino-Abhängigkeit, tools/ binden diese Datei direkt ein
+*/
+
+#pragma once
+#include <stdint.h>
+
+constexpr uint32_t LOG_MAGIC       = 0x31474C53UL;   // "SLG1"
+constexpr uint8_t  LOG_VERSION     = 1;
+constexpr uint16_t LOG_BLOCK_SIZE  = 512;
+constexpr uint8_t  LOG_RECORDS_PER_BLOCK = 30;
+
+enum class LogType : uint8_t {
+  IMU     = 1,   // v0 Roll 0,01 °, v1 Pitch 0,01 °, v2 Kurs 0,1 °
+  Mag     = 2,   // v0..v2 Magnetfeld X/Y/Z in 0,1 µT (Board-Achsen, ohne Hard/Soft-Iron-Korrektur)
+  Env     = 3,   // v0 Temperatur 0,01 °C, v1 Feuchte 0,01 %, v2 Druck (hPa - 1000) in 0,01 hPa
+  Battery = 4,   // v0 Spannung mV, v1 Ladezustand %
+  GPSPos  = 5,   // pos: Breite/Länge 1e-7 °
+  GPSVel  = 6,   // v0 SOG 0,01 kn, v1 COG 0,01 ° (beide unsigned), v2 HDOP*100, v3 Satelliten
+  Event   = 7,   // v0 Code, v1 Argument (Taster, Alarme)
+  Replay  = 8    // bytes: Stück des Replay-Stroms, flags siehe replay_format.h
+};
+
+#pragma pack(push, 1)
+
+struct LogRecord {
+  uint32_t timeMs;       // millis() beim Erfassen
+  uint8_t  type;         // LogType
+  uint8_t  flags;
+  union {
+    int16_t v[5];
+    uint8_t bytes[10];
+    struct {
+      int32_t  latE7;
+      int32_t  lonE7;
+      uint16_t reserved;
+    } pos;
+  };
+};
+
+struct LogBlockHeader {
+  uint32_t magic;
+  uint32_t seq;          // fortlaufend ab 0 pro Datei
+  uint32_t startEpoch;   // Unix-Zeit (RTC) beim ersten Datensatz ...
+  uint32_t startMs;      // ... und millis() im selben Moment
+  uint8_t  count;        // belegte Datensätze
+  uint8_t  version;
+  uint16_t dropped;      // seit dem letzten Block verworfene Datensätze
+  uint16_t fileNumber;   // LOGnnnnn.BIN
+  uint32_t fileEpoch;    // Unix-Zeit (RTC) beim Anlegen der Datei
+  uint8_t  reserved[4];
+  uint16_t crc;          // über records[0 .. count)
+};
+
+struct LogBlock {
+  LogBlockHeader header;
+  LogRecord      records[LOG_RECORDS_PER_BLOCK];
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(LogRecord) == 16, "LogRecord muss 16 Byte haben");
+static_assert(sizeof(LogBlock) == LOG_BLOCK_SIZE, "LogBlock muss genau einen Sektor füllen");
+
+inline uint16_t logCrcUpdate(uint16_t crc, uint8_t data) {
+  data ^= (uint8_t)(crc & 0xFF);
+  data ^= (uint8_t)(data << 4);
+  return (uint16_t)((((uint16_t)data << 8) | (crc >> 8)) ^ (uint8_t)(data >> 4) ^ ((uint16_t)data << 3));
+}
+
+inline uint16_t logCrc(const void* data, uint16_t len) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  uint16_t crc = 0xFFFF;
+  while (len--) crc = logCrcUpdate(crc, *p++);
+  return crc;
+}
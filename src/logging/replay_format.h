@@ -0,0 +1,61 @@
+/*
+Rolle: Format des Replay-Stroms (Rohdaten der Sensoren, Gerät und PC-Tools).
+
+Inhalt:
+
+Byte-Strom aus Einträgen: Tag (1 Byte) + dt (1 Byte) + Inhalt fester
+Länge je Tag. dt = ms seit dem vorigen Eintrag; dt = 255 heißt, dass
+danach millis() absolut als uint32 folgt (erster Eintrag, Lücken > 254 ms).
+
+Floats werden bitgenau abgelegt (IEEE 754, little endian wie AVR und x86),
+damit das Abspielen dieselben Eingangswerte sieht wie das Gerät.
+
+Transport: in 10-Byte-Stücken als LogRecord vom Typ LogType::Replay in
+der normalen Logdatei (log_format.h). flags = Anzahl Bytes (Bits 0-3) und
+Offset des ersten Eintragsbeginns im Stück (Bits 4-7, 15 = keiner). Nach
+verlorenen Datensätzen setzt der Leser dort wieder auf und wartet auf den
+nächsten Clock-Eintrag (absolute Zeit).
+
+Keine Arduino-Abhängigkeit, tools/ binden diese Datei direkt ein
+*/
+
+#pragma once
+#include <stdint.h>
+
+enum class ReplayTag : uint8_t {
+  Loop   = 1,   // ohne Inhalt: handleAlarms() dieser loop()-Runde
+  Clock  = 2,   // uint32 Unix-Zeit (RTC, bei jedem Sekundenwechsel), uint32 millis()
+  Imu    = 3,   // 6 float: Beschleunigung X/Y/Z in g, Magnetfeld X/Y/Z in µT (Chip-Achsen)
+  Knock  = 4,   // int16 quer, int16 vertikal: Rohwerte aus dem Data-Ready-ISR
+  Env    = 5,   // 3 float: Temperatur °C, Feuchte %, Druck Pa (wie vom BME280 gelesen)
+  Button = 6    // uint8 buttonId, uint8 ButtonEventType
+};
+
+constexpr uint8_t REPLAY_DT_ABSOLUTE = 255;
+constexpr uint8_t REPLAY_CHUNK_BYTES = 10;
+constexpr uint8_t REPLAY_NO_ENTRY    = 0x0F;
+
+// Länge des Inhalts nach Tag und dt, -1 = unbekannter Tag
+inline int8_t replayPayloadSize(uint8_t tag) {
+  switch (static_cast<ReplayTag>(tag)) {
+    case ReplayTag::Loop:   return 0;
+    case ReplayTag::Clock:  return 8;
+    case ReplayTag::Imu:    return 24;
+    case ReplayTag::Knock:  return 4;
+    case ReplayTag::Env:    return 12;
+    case ReplayTag::Button: return 2;
+  }
+  return -1;
+}
+
+inline uint8_t replayChunkFlags(uint8_t count, uint8_t firstEntry) {
+  return (uint8_t)((count & 0x0F) | (firstEntry << 4));
+}
+
+inline uint8_t replayChunkCount(uint8_t flags) {
+  return flags & 0x0F;
+}
+
+inline uint8_t replayChunkFirstEntry(uint8_t flags) {
+  return flags >> 4;
+}
@@ -0,0 +1,276 @@
+/*
+Rolle: Binär-Logger auf SD-Karte.
+
+Inhalt:
+
+SdFat (DEDICATED_SPI), weil die Arduino-SD-Library weder vorreservierte
+Dateien noch isBusy() kennt
+
+Ablauf pro Datei: anlegen -> preAllocate() -> contiguousRange() ->
+writeStart(ersterSektor) -> je Block ein writeData() -> writeStop() ->
+truncate() auf die geschriebene Länge
+
+Puffer: blocks[fill] wird befüllt, blocks[pending] wartet auf die Karte
+(-1 = nichts offen). seq und Dateikennung bekommt ein Block erst beim
+Schreiben: beim Dateiwechsel kann schon ein voller Block warten, der
+gehört dann in die neue Datei.
+
+Schlägt writeData() fehl (Karte gezogen/defekt), wird die Datei so weit
+wie möglich abgeschlossen und der Logger geht auf Off
+*/
+
+#include <Arduino.h>
+#include <SdFat.h>
+#include "config.h"
+#include "rtc_module.h"
+#include "sd_logger.h"
+
+namespace {
+
+  enum class State : uint8_t { Off, Writing, NextFile };
+
+  SdFs   sd;
+  FsFile file;
+  State  state = State::Off;
+
+  LogBlock blocks[2];
+  uint8_t  fill = 0;
+  int8_t   pending = -1;
+  uint32_t blockSeq = 0;
+  uint16_t droppedSinceBlock = 0;
+
+  uint32_t nextSector = 0;
+  uint32_t lastSector = 0;
+  uint32_t blocksInFile = 0;
+  uint32_t blocksWritten = 0;
+  uint32_t droppedTotal = 0;
+  uint16_t fileNumber = 0;
+  uint32_t fileEpoch = 0;
+  uint16_t writeErrors = 0;
+
+  int16_t clamp16(float v) {
+    if (v < -32768.0f) return -32768;
+    if (v >  32767.0f) return  32767;
+    return (int16_t)lroundf(v);
+  }
+
+  bool openNextFile() {
+    char name[13];
+    do {
+      snprintf(name, sizeof(name), "LOG%05u.BIN", ++fileNumber);
+    } while (sd.exists(name) && fileNumber < 65535);
+
+    if (!file.open(name, O_RDWR | O_CREAT | O_TRUNC)) return false;
+    if (!file.preAllocate((uint64_t)LOG_PREALLOC_BLOCKS * LOG_BLOCK_SIZE)
+        || !file.contiguousRange(&nextSector, &lastSector)
+        || !sd.card()->writeStart(nextSector)) {
+      file.close();
+      return false;
+    }
+    blocksInFile = 0;
+    blockSeq = 0;
+    fileEpoch = RTCModule::getUnixTime();
+    return true;
+  }
+
+  void closeFile() {
+    sd.card()->writeStop();
+    // Vorreservierten Rest abschneiden, damit der Decoder nur echte Blöcke sieht
+    file.truncate((uint64_t)blocksInFile * LOG_BLOCK_SIZE);
+    file.close();
+  }
+
+  // Vollen Puffer abschließen und zum Schreiben freigeben
+  bool seal() {
+    if (pending >= 0) return false;
+    LogBlock& b = blocks[fill];
+    b.header.magic   = LOG_MAGIC;
+    b.header.version = LOG_VERSION;
+    b.header.dropped = droppedSinceBlock;
+    b.header.crc     = logCrc(b.records, b.header.count * sizeof(LogRecord));
+    droppedSinceBlock = 0;
+
+    pending = fill;
+    fill ^= 1;
+    blocks[fill].header.count = 0;
+    return true;
+  }
+
+  // false = Karte hat den Block nicht angenommen
+  bool writePending() {
+    LogBlock& b = blocks[pending];
+    b.header.seq        = blockSeq;
+    b.header.fileNumber = fileNumber;
+    b.header.fileEpoch  = fileEpoch;
+    if (!sd.card()->writeData(reinterpret_cast<const uint8_t*>(&b))) {
+      writeErrors++;
+      return false;
+    }
+    pending = -1;
+    blockSeq++;
+    nextSector++;
+    blocksInFile++;
+    blocksWritten++;
+    return true;
+  }
+
+  void failFile() {
+    pending = -1;
+    closeFile();      // bei gezogener Karte wirkungslos, sonst bleibt die Datei lesbar
+    state = State::Off;
+  }
+
+}
+
+namespace SDLogger {
+
+  bool begin() {
+    if (!sd.begin(SdSpiConfig(PIN_SD_CS, DEDICATED_SPI, SD_SCK_MHZ(16)))) return false;
+    memset(blocks, 0, sizeof(blocks));
+    fill = 0;
+    pending = -1;
+    if (!openNextFile()) return false;
+    state = State::Writing;
+    return true;
+  }
+
+  void update() {
+    switch (state) {
+      case State::Off:
+        return;
+
+      case State::Writing:
+        if (pending < 0 || sd.card()->isBusy()) return;
+        if (!writePending()) {
+          failFile();
+          return;
+        }
+        if (nextSector > lastSector) {
+          closeFile();
+          state = State::NextFile;   // neue Datei erst im nächsten Schritt
+        }
+        return;
+
+      case State::NextFile:
+        if (sd.card()->isBusy()) return;
+        state = openNextFile() ? State::Writing : State::Off;
+        return;
+    }
+  }
+
+  void stop() {
+    if (state == State::Off) return;
+    if (state == State::Writing) {
+      while (pending >= 0 || blocks[fill].header.count > 0) {
+        if (pending < 0) seal();
+        while (sd.card()->isBusy()) {}
+        if (nextSector > lastSector || !writePending()) break;
+      }
+      closeFile();
+    }
+    state = State::Off;
+  }
+
+  bool isLogging() {
+    return state != State::Off;
+  }
+
+  bool log(const LogRecord& rec) {
+    if (state == State::Off) return false;
+
+    LogBlock& b = blocks[fill];
+    if (b.header.count >= LOG_RECORDS_PER_BLOCK && !seal()) {
+      droppedSinceBlock++;
+      droppedTotal++;
+      return false;
+    }
+
+    LogBlock& cur = blocks[fill];
+    if (cur.header.count == 0) {
+      cur.header.startEpoch = RTCModule::getUnixTime();
+      cur.header.startMs = millis();
+    }
+    cur.records[cur.header.count++] = rec;
+    if (cur.header.count == LOG_RECORDS_PER_BLOCK) seal();
+    return true;
+  }
+
+  void logIMU(const IMUData& imu) {
+    LogRecord r = {};
+    r.timeMs = millis();
+    r.type = static_cast<uint8_t>(LogType::IMU);
+    r.v[0] = clamp16(imu.roll * 100.0f);
+    r.v[1] = clamp16(imu.pitch * 100.0f);
+    r.v[2] = clamp16(imu.yaw * 10.0f);
+    log(r);
+  }
+
+  void logMag(const IMUData& imu) {
+    LogRecord r = {};
+    r.timeMs = millis();
+    r.type = static_cast<uint8_t>(LogType::Mag);
+    r.v[0] = clamp16(imu.magX * 10.0f);
+    r.v[1] = clamp16(imu.magY * 10.0f);
+    r.v[2] = clamp16(imu.magZ * 10.0f);
+    log(r);
+  }
+
+  void logEnv(const EnvData& env) {
+    LogRecord r = {};
+    r.timeMs = millis();
+    r.type = static_cast<uint8_t>(LogType::Env);
+    r.v[0] = clamp16(env.temperature * 100.0f);
+    r.v[1] = clamp16(env.humidity * 100.0f);
+    r.v[2] = clamp16((env.pressure - 1000.0f) * 100.0f);
+    log(r);
+  }
+
+  void logBattery(const BatteryStatus& bat) {
+    LogRecord r = {};
+    r.timeMs = millis();
+    r.type = static_cast<uint8_t>(LogType::Battery);
+    r.v[0] = clamp16(bat.voltage * 1000.0f);
+    r.v[1] = clamp16(bat.percentage);
+    log(r);
+  }
+
+  void logGPS(const GPSData& gps) {
+    LogRecord r = {};
+    r.timeMs = millis();
+    r.type = static_cast<uint8_t>(LogType::GPSPos);
+    r.pos.latE7 = gps.latE7;
+    r.pos.lonE7 = gps.lonE7;
+    log(r);
+
+    r = LogRecord();
+    r.timeMs = millis();
+    r.type = static_cast<uint8_t>(LogType::GPSVel);
+    r.v[0] = (int16_t)gps.sogCKn;
+    r.v[1] = (int16_t)gps.cogCDeg;
+    r.v[2] = (int16_t)gps.hdopC;
+    r.v[3] = gps.satellites;
+    log(r);
+  }
+
+  void logEvent(uint8_t code, int16_t arg) {
+    LogRecord r = {};
+    r.timeMs = millis();
+    r.type = static_cast<uint8_t>(LogType::Event);
+    r.v[0] = code;
+    r.v[1] = arg;
+    log(r);
+  }
+
+  uint32_t getBlocksWritten() {
+    return blocksWritten;
+  }
+
+  uint32_t getDroppedRecords() {
+    return droppedTotal;
+  }
+
+  uint16_t getWriteErrors() {
+    return writeErrors;
+  }
+
+}
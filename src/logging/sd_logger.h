@@ -0,0 +1,42 @@
+/*
+Rolle: Binär-Logger auf SD-Karte.
+
+Inhalt:
+
+Datensätze fester Größe (log_format.h) landen in einem von zwei
+512-Byte-Puffern; ist ein Puffer voll, wird er zum Schreiben freigegeben
+und der andere weiter befüllt
+
+Die Logdatei wird beim Anlegen zusammenhängend vorreserviert und danach
+direkt sektorweise beschrieben (Multi-Block-Write, kein FAT-Update pro
+Block)
+
+update() schreibt höchstens einen Sektor und nur, wenn die Karte nicht
+mehr beschäftigt ist -> loop() wartet nie auf die Karte. Sind beide
+Puffer voll, werden neue Datensätze verworfen und gezählt.
+*/
+
+#pragma once
+#include <stdint.h>
+#include "types.h"
+#include "log_format.h"
+#include "nmea_parser.h"
+
+namespace SDLogger {
+  bool begin();                  // Karte + neue Datei LOGnnnnn.BIN
+  void update();                 // ein kleiner Schritt, jede loop()-Runde
+  void stop();                   // Rest schreiben, Datei auf Länge kürzen (blockiert)
+  bool isLogging();
+
+  bool log(const LogRecord& rec);
+  void logIMU(const IMUData& imu);
+  void logMag(const IMUData& imu);
+  void logEnv(const EnvData& env);
+  void logBattery(const BatteryStatus& bat);
+  void logGPS(const GPSData& gps);
+  void logEvent(uint8_t code, int16_t arg);
+
+  uint32_t getBlocksWritten();
+  uint32_t getDroppedRecords();
+  uint16_t getWriteErrors();       // abgelehnte Blöcke, danach ist der Logger aus
+}
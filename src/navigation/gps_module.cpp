@@ -0,0 +1,48 @@
+/*
+Rolle: GPS-Empfänger (NEO-6M an Serial1).
+*/
+
+#include <Arduino.h>
+#include "config.h"
+#include "gps_module.h"
+
+namespace {
+
+  NmeaParser parser;
+  uint32_t fixTime = 0;
+
+  // Pro Aufruf höchstens so viele Zeichen, damit loop() nicht hängt,
+  // falls der Empfänger gerade einen ganzen Block schickt
+  constexpr uint8_t MAX_BYTES_PER_UPDATE = 64;
+
+}
+
+namespace GPSModule {
+
+  void begin() {
+    Serial1.begin(GPS_BAUD);
+  }
+
+  void update() {
+    uint8_t budget = MAX_BYTES_PER_UPDATE;
+    while (budget-- > 0 && Serial1.available() > 0) {
+      NmeaSentence s = parser.feed((char)Serial1.read());
+      if (s == NmeaSentence::RMC && parser.data().fixValid) {
+        fixTime = millis();
+      }
+    }
+  }
+
+  const GPSData& getData() {
+    return parser.data();
+  }
+
+  bool hasFix() {
+    return parser.data().fixValid && millis() - fixTime < GPS_FIX_TIMEOUT_MS;
+  }
+
+  uint32_t lastFixMs() {
+    return fixTime;
+  }
+
+}
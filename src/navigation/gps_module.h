@@ -0,0 +1,23 @@
+/*
+Rolle: GPS-Empfänger (NEO-6M an Serial1).
+
+Inhalt:
+
+begin(): Serial1 öffnen
+
+update(): alle bis jetzt empfangenen Bytes an den NmeaParser geben,
+blockiert nie
+
+getData(): letzter Stand aus RMC/GGA/VTG
+*/
+
+#pragma once
+#include "nmea_parser.h"
+
+namespace GPSModule {
+  void begin();
+  void update();
+  const GPSData& getData();
+  bool hasFix();
+  uint32_t lastFixMs();      // millis() des letzten gültigen RMC
+}
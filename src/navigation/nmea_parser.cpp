@@ -0,0 +1,225 @@
+/*
+Rolle: Streaming-Parser für NMEA 0183 (GPS, z. B. NEO-6M).
+
+Inhalt:
+
+Zustandsautomat pro Zeichen: '$' startet einen Satz, '*' leitet die
+Prüfsumme ein, nach zwei Hex-Ziffern wird der Satz sofort ausgewertet
+(CR/LF wird nicht abgewartet)
+
+Felder werden als Festkomma gelesen: "4807.038" mit 3 Nachkommastellen
+-> 4807038. Zu viele Stellen werden abgeschnitten, fehlende aufgefüllt.
+*/
+
+#include <string.h>
+#include "nmea_parser.h"
+
+namespace {
+
+  uint8_t hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return 0xFF;
+  }
+
+  bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+  }
+
+  uint8_t twoDigits(const char* s) {
+    return (s[0] - '0') * 10 + (s[1] - '0');
+  }
+
+  // "[-]123.456" -> Ganzzahl mit 'decimals' Nachkommastellen
+  bool parseFixed(const char* s, uint8_t decimals, int32_t& out) {
+    if (*s == '\0') return false;
+    bool neg = false;
+    if (*s == '-') { neg = true; ++s; }
+
+    int32_t v = 0;
+    bool any = false;
+    while (isDigit(*s)) { v = v * 10 + (*s++ - '0'); any = true; }
+    if (*s == '.') {
+      ++s;
+      while (isDigit(*s) && decimals > 0) { v = v * 10 + (*s++ - '0'); --decimals; any = true; }
+      while (isDigit(*s)) ++s;
+    }
+    if (!any || *s != '\0') return false;
+    while (decimals-- > 0) v *= 10;
+
+    out = neg ? -v : v;
+    return true;
+  }
+
+  // "ddmm.mmmmm" / "dddmm.mmmmm" + Halbkugel -> 1e-7 °
+  bool parseCoord(const char* s, const char* hemi, uint8_t degDigits, int32_t& out) {
+    for (uint8_t i = 0; i < degDigits; ++i) {
+      if (!isDigit(s[i])) return false;
+    }
+    int32_t deg = 0;
+    for (uint8_t i = 0; i < degDigits; ++i) deg = deg * 10 + (s[i] - '0');
+
+    int32_t minE5;
+    if (!parseFixed(s + degDigits, 5, minE5)) return false;
+
+    // Minuten * 1e5 -> Grad * 1e7: * 100 / 60
+    int32_t v = deg * 10000000L + minE5 * 5 / 3;
+    if (*hemi == 'S' || *hemi == 'W') v = -v;
+    out = v;
+    return true;
+  }
+
+  bool parseTime(const char* s, GPSData& gps) {
+    for (uint8_t i = 0; i < 6; ++i) {
+      if (!isDigit(s[i])) return false;
+    }
+    gps.hour   = twoDigits(s);
+    gps.minute = twoDigits(s + 2);
+    gps.second = twoDigits(s + 4);
+    gps.centisecond = 0;
+    if (s[6] == '.' && isDigit(s[7])) {
+      gps.centisecond = (s[7] - '0') * 10;
+      if (isDigit(s[8])) gps.centisecond += s[8] - '0';
+    }
+    gps.timeValid = true;
+    return true;
+  }
+
+  bool parseDate(const char* s, GPSData& gps) {
+    for (uint8_t i = 0; i < 6; ++i) {
+      if (!isDigit(s[i])) return false;
+    }
+    gps.day   = twoDigits(s);
+    gps.month = twoDigits(s + 2);
+    gps.year  = 2000 + twoDigits(s + 4);
+    gps.dateValid = true;
+    return true;
+  }
+
+}
+
+NmeaParser::NmeaParser()
+  : len(0), sum(0), given(0), givenDigits(0), state(State::Idle),
+    gps(), goodCount(0), badCount(0) {
+}
+
+NmeaSentence NmeaParser::feed(char c) {
+  if (c == '$') {
+    state = State::Body;
+    len = 0;
+    sum = 0;
+    return NmeaSentence::None;
+  }
+
+  switch (state) {
+    case State::Idle:
+      return NmeaSentence::None;
+
+    case State::Body:
+      if (c == '*') {
+        state = State::Checksum;
+        given = 0;
+        givenDigits = 0;
+      } else if (c == '\r' || c == '\n') {
+        // Satz ohne Prüfsumme wird nicht akzeptiert
+        state = State::Idle;
+        badCount++;
+        return NmeaSentence::BadChecksum;
+      } else if (len >= BUF_SIZE - 1) {
+        state = State::Idle;   // zu lang, verwerfen
+      } else {
+        buf[len++] = c;
+        sum ^= (uint8_t)c;
+      }
+      return NmeaSentence::None;
+
+    case State::Checksum: {
+      uint8_t h = hexValue(c);
+      if (h == 0xFF) {
+        state = State::Idle;
+        badCount++;
+        return NmeaSentence::BadChecksum;
+      }
+      given = (given << 4) | h;
+      if (++givenDigits < 2) return NmeaSentence::None;
+
+      state = State::Idle;
+      if (given != sum) {
+        badCount++;
+        return NmeaSentence::BadChecksum;
+      }
+      goodCount++;
+      buf[len] = '\0';
+      return finish();
+    }
+  }
+  return NmeaSentence::None;
+}
+
+uint8_t NmeaParser::split(char* fields[]) {
+  uint8_t n = 0;
+  fields[n++] = buf;
+  for (uint8_t i = 0; i < len; ++i) {
+    if (buf[i] != ',') continue;
+    buf[i] = '\0';
+    if (n >= MAX_FIELDS) break;
+    fields[n++] = &buf[i + 1];
+  }
+  return n;
+}
+
+NmeaSentence NmeaParser::finish() {
+  char* f[MAX_FIELDS];
+  uint8_t n = split(f);
+
+  // Talker (GP, GN, GL ...) ignorieren, nur der Satztyp zählt
+  if (strlen(f[0]) != 5) return NmeaSentence::Other;
+  const char* type = f[0] + 2;
+
+  if (memcmp(type, "RMC", 3) == 0) { parseRMC(f, n); return NmeaSentence::RMC; }
+  if (memcmp(type, "GGA", 3) == 0) { parseGGA(f, n); return NmeaSentence::GGA; }
+  if (memcmp(type, "VTG", 3) == 0) { parseVTG(f, n); return NmeaSentence::VTG; }
+  return NmeaSentence::Other;
+}
+
+// $GPRMC,hhmmss.ss,A,llll.ll,a,yyyyy.yy,a,x.x,x.x,ddmmyy,x.x,a*hh
+void NmeaParser::parseRMC(char* f[], uint8_t n) {
+  if (n < 10) return;
+  parseTime(f[1], gps);
+  parseDate(f[9], gps);
+
+  gps.fixValid = (f[2][0] == 'A');
+  if (!gps.fixValid) return;
+
+  parseCoord(f[3], f[4], 2, gps.latE7);
+  parseCoord(f[5], f[6], 3, gps.lonE7);
+
+  int32_t v;
+  if (parseFixed(f[7], 2, v)) gps.sogCKn  = (uint16_t)v;
+  if (parseFixed(f[8], 2, v)) gps.cogCDeg = (uint16_t)v;
+}
+
+// $GPGGA,hhmmss.ss,llll.ll,a,yyyyy.yy,a,q,nn,h.h,alt,M,geo,M,age,ref*hh
+void NmeaParser::parseGGA(char* f[], uint8_t n) {
+  if (n < 10) return;
+  parseTime(f[1], gps);
+
+  int32_t v;
+  if (parseFixed(f[6], 0, v)) gps.fixQuality = (uint8_t)v;
+  if (parseFixed(f[7], 0, v)) gps.satellites = (uint8_t)v;
+  if (parseFixed(f[8], 2, v)) gps.hdopC      = (uint16_t)v;
+  if (gps.fixQuality == 0) return;
+
+  parseCoord(f[2], f[3], 2, gps.latE7);
+  parseCoord(f[4], f[5], 3, gps.lonE7);
+  if (parseFixed(f[9], 2, v)) gps.altitudeCm = v;
+}
+
+// $GPVTG,cog,T,cogM,M,sog,N,kmh,K,mode*hh
+void NmeaParser::parseVTG(char* f[], uint8_t n) {
+  if (n < 6) return;
+  int32_t v;
+  if (parseFixed(f[1], 2, v)) gps.cogCDeg = (uint16_t)v;
+  if (parseFixed(f[5], 2, v)) gps.sogCKn  = (uint16_t)v;
+}
@@ -0,0 +1,80 @@
+/*
+Rolle: Streaming-Parser für NMEA 0183 (GPS, z. B. NEO-6M).
+
+Inhalt:
+
+Nimmt Byte für Byte entgegen (direkt aus Serial1), sammelt einen Satz
+in einem festen Puffer (max. 82 Zeichen laut NMEA)
+
+Prüfsumme (*hh) wird schon beim Empfang mitgerechnet
+
+Auswertung von RMC, GGA und VTG direkt im Puffer: Kommas werden zu
+'\0', Felder sind Zeiger in den Puffer. Kein String, kein Heap.
+
+Werte als Festkomma-Ganzzahlen (kein float/atof auf dem AVR)
+
+Keine Arduino-Abhängigkeit, damit der Parser auch auf dem PC
+(tools/nmea_replay) läuft
+*/
+
+#pragma once
+#include <stdint.h>
+
+enum class NmeaSentence : uint8_t { None, RMC, GGA, VTG, Other, BadChecksum };
+
+struct GPSData {
+  // UTC
+  uint8_t  hour, minute, second, centisecond;
+  uint8_t  day, month;
+  uint16_t year;
+
+  int32_t  latE7;          // Breite in 1e-7 °, Nord positiv
+  int32_t  lonE7;          // Länge in 1e-7 °, Ost positiv
+  uint16_t sogCKn;         // Fahrt über Grund in 0,01 kn
+  uint16_t cogCDeg;        // Kurs über Grund in 0,01 °
+  int32_t  altitudeCm;     // Höhe über NN
+  uint16_t hdopC;          // HDOP * 100
+  uint8_t  satellites;
+  uint8_t  fixQuality;     // GGA: 0 = kein Fix, 1 = GPS, 2 = DGPS ...
+
+  bool     timeValid;      // Uhrzeit gesetzt (auch ohne Positions-Fix)
+  bool     dateValid;
+  bool     fixValid;       // RMC-Status 'A'
+};
+
+class NmeaParser {
+public:
+  NmeaParser();
+
+  // Ein Zeichen verarbeiten. Liefert den Satztyp, sobald ein Satz
+  // vollständig ist, sonst NmeaSentence::None.
+  NmeaSentence feed(char c);
+
+  const GPSData& data() const { return gps; }
+
+  uint32_t sentenceCount() const { return goodCount; }
+  uint32_t checksumErrors() const { return badCount; }
+
+private:
+  static const uint8_t BUF_SIZE   = 83;   // '$' .. '*hh' ohne CR/LF + '\0'
+  static const uint8_t MAX_FIELDS = 20;
+
+  enum class State : uint8_t { Idle, Body, Checksum };
+
+  NmeaSentence finish();
+  uint8_t split(char* fields[]);
+  void parseRMC(char* f[], uint8_t n);
+  void parseGGA(char* f[], uint8_t n);
+  void parseVTG(char* f[], uint8_t n);
+
+  char    buf[BUF_SIZE];
+  uint8_t len;
+  uint8_t sum;             // XOR über alles zwischen '$' und '*'
+  uint8_t given;           // empfangene Prüfsumme
+  uint8_t givenDigits;
+  State   state;
+
+  GPSData  gps;
+  uint32_t goodCount;
+  uint32_t badCount;
+};
@@ -8,4 +8,84 @@ Klasse oder Namespace wie BME280Sensor
 begin(), update(), getData()
 
 Interner Umgang mit der verwendeten BME-Library (Adafruit o. ä.)
+
+Luftdrucktendenz: alle 15 min ein Druckwert in einen Ring über 3 h,
+Tendenz = neuester - ältester Wert, auf 3 h hochgerechnet
 */
+
+#include <Arduino.h>
+#include <Adafruit_Sensor.h>
+#include <Adafruit_BME280.h>
+#include "config.h"
+#include "i2c_bus.h"
+#include "input_recorder.h"
+#include "bme280_sensor.h"
+
+namespace {
+
+  Adafruit_BME280 bme;
+  EnvData data = {};
+  bool present = false;             // begin() erfolgreich
+
+  constexpr uint8_t TREND_SLOTS = 13;                 // 0 .. 3 h in 15-min-Schritten
+  constexpr unsigned long TREND_INTERVAL_MS = 15UL * 60UL * 1000UL;
+  constexpr uint8_t TREND_MIN_SLOTS = 4;              // mindestens 45 min
+
+  float trendRing[TREND_SLOTS];
+  uint8_t trendIndex = 0;                             // nächster Schreibplatz
+  uint8_t trendCount = 0;
+  unsigned long trendLastSample = 0;
+
+}
+
+namespace BME280Sensor {
+
+  bool begin() {
+    // Adresse aus der Geräte-Tabelle (BME280_ADDR oder die Alternative)
+    uint8_t addr = I2CBus::address(I2CDevice::Bme);
+    if (addr == I2C_NO_DEVICE) return false;
+    present = bme.begin(addr);
+    return present;
+  }
+
+  bool isPresent() {
+    return present;
+  }
+
+  void update() {
+    // ohne begin() hat die Library kein Gerät, read*() wäre undefiniert
+    if (!present) return;
+    I2CBus::lock();
+    data.temperature = bme.readTemperature();         // °C
+    data.humidity    = bme.readHumidity();            // %
+    float pressurePa = bme.readPressure();
+    I2CBus::unlock();
+    data.pressure = pressurePa / 100.0f;              // hPa
+    InputRecorder::recordEnv(data.temperature, data.humidity, pressurePa);
+
+    unsigned long now = millis();
+    if (trendCount == 0 || now - trendLastSample >= TREND_INTERVAL_MS) {
+      trendRing[trendIndex] = data.pressure;
+      trendIndex = (trendIndex + 1) % TREND_SLOTS;
+      if (trendCount < TREND_SLOTS) trendCount++;
+      trendLastSample = now;
+    }
+  }
+
+  EnvData getEnvData() {
+    return data;
+  }
+
+  bool hasPressureTrend() {
+    return trendCount >= TREND_MIN_SLOTS;
+  }
+
+  float getPressureTrend() {
+    if (!hasPressureTrend()) return 0.0f;
+    uint8_t newest = (trendIndex + TREND_SLOTS - 1) % TREND_SLOTS;
+    uint8_t oldest = (trendIndex + TREND_SLOTS - trendCount) % TREND_SLOTS;
+    float diff = trendRing[newest] - trendRing[oldest];
+    return diff * (TREND_SLOTS - 1) / (trendCount - 1);
+  }
+
+}
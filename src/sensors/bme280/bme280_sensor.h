@@ -15,7 +15,9 @@ Interner Umgang mit der verwendeten BME-Library (Adafruit o. ä.)
 
 namespace BME280Sensor {
   bool begin();
+  bool isPresent();                // begin() hat den Sensor gefunden
   void update();
   EnvData getEnvData();
+  bool  hasPressureTrend();       // erst nach ca. 45 min Historie aussagekräftig
+  float getPressureTrend();       // hPa pro 3 h (negativ = fallend)
 }
-
@@ -0,0 +1,194 @@
+/*
+Rolle: Laufende Hard-/Soft-Iron-Kalibrierung des Magnetometers (X/Y).
+
+Inhalt:
+
+Sektor ohne atan2(): Quadrant aus den Vorzeichen, innerhalb des
+Quadranten |dy| gegen |dx| * tan 30° / tan 60°.
+
+Sektor-Zuordnung relativ zum Mittelpunkt der vorigen Sitzung (am Anfang
+der gespeicherte Offset). Liegt der außerhalb von Min/Max der Sitzung
+(Offset weit daneben), gilt stattdessen die Mitte von Min/Max; falsch
+zugeordnete Werte erhöhen nur die Streuung, die Sitzung wird verworfen
+und die nächste beginnt mit dem besseren Mittelpunkt.
+
+Der Mittelwert der Punkte eines 30°-Bogens liegt ca. 1 % innerhalb des
+Kreises, für alle Sektoren gleich; die Streuung misst also die Form.
+*/
+
+#include <Arduino.h>
+#include "config.h"
+#include "mag_calibrator.h"
+
+namespace {
+
+  constexpr uint8_t  SECTORS = 12;
+  constexpr uint16_t ALL_SECTORS = (1 << SECTORS) - 1;
+  constexpr float TAN30 = 0.57735f;
+  constexpr float TAN60 = 1.73205f;
+
+  MagCalibration fit = {};
+  MagFitQuality lastQuality = {};
+
+  float centre[2];
+  float lp[2];
+  float lo[2], hi[2];
+  float secSum[SECTORS][2];
+  uint16_t secCount[SECTORS];
+  uint16_t sectorMask = 0;
+  uint16_t samples = 0;
+  unsigned long sessionStart = 0;
+
+  void startSession() {
+    samples = 0;
+    sectorMask = 0;
+    for (uint8_t s = 0; s < SECTORS; ++s) {
+      secSum[s][0] = 0;
+      secSum[s][1] = 0;
+      secCount[s] = 0;
+    }
+    sessionStart = millis();
+  }
+
+  uint8_t sectorOf(float dx, float dy) {
+    float ax = fabs(dx);
+    float ay = fabs(dy);
+    uint8_t s = ay < ax * TAN30 ? 0 : (ay < ax * TAN60 ? 1 : 2);
+    if (dx >= 0) return dy >= 0 ? s : 11 - s;
+    return dy >= 0 ? 5 - s : 6 + s;
+  }
+
+  // false = Spannweite zu klein für einen Fit
+  bool computeFit(MagCalibration& out, float& radius) {
+    float hx = (hi[0] - lo[0]) * 0.5f;
+    float hy = (hi[1] - lo[1]) * 0.5f;
+    if (hx < MAG_CAL_MIN_RADIUS_UT || hy < MAG_CAL_MIN_RADIUS_UT) return false;
+    radius = (hx + hy) * 0.5f;
+    out = fit;
+    out.offset[0] = (hi[0] + lo[0]) * 0.5f;
+    out.offset[1] = (hi[1] + lo[1]) * 0.5f;
+    out.scale[0] = radius / hx;
+    out.scale[1] = radius / hy;
+    return true;
+  }
+
+  uint8_t spreadPct(const MagCalibration& c, float radius) {
+    float rMin = 1e9f;
+    float rMax = 0;
+    for (uint8_t s = 0; s < SECTORS; ++s) {
+      if (secCount[s] == 0) continue;
+      float dx = (secSum[s][0] / secCount[s] - c.offset[0]) * c.scale[0];
+      float dy = (secSum[s][1] / secCount[s] - c.offset[1]) * c.scale[1];
+      float r = sqrt(dx * dx + dy * dy);
+      rMin = min(rMin, r);
+      rMax = max(rMax, r);
+    }
+    if (rMax <= rMin) return 0;
+    float pct = (rMax - rMin) * 100.0f / radius;
+    return pct > 255.0f ? 255 : (uint8_t)(pct + 0.5f);
+  }
+
+  uint8_t sectorCount() {
+    uint8_t n = 0;
+    for (uint16_t m = sectorMask; m; m &= m - 1) n++;
+    return n;
+  }
+
+  bool changedEnough(const MagCalibration& a, const MagCalibration& b) {
+    for (uint8_t i = 0; i < 2; ++i) {
+      if (fabs(a.offset[i] - b.offset[i]) > MAG_CAL_MIN_CHANGE_UT) return true;
+      if (fabs(a.scale[i] - b.scale[i]) > 0.01f) return true;
+    }
+    return false;
+  }
+
+}
+
+namespace MagCalibrator {
+
+  void begin(const MagCalibration& current) {
+    fit = current;
+    centre[0] = current.offset[0];
+    centre[1] = current.offset[1];
+    startSession();
+  }
+
+  bool addSample(float mx, float my) {
+    if (samples == 0) {
+      lp[0] = mx;
+      lp[1] = my;
+      lo[0] = hi[0] = mx;
+      lo[1] = hi[1] = my;
+    } else {
+      lp[0] += (mx - lp[0]) * MAG_CAL_LP;
+      lp[1] += (my - lp[1]) * MAG_CAL_LP;
+    }
+    for (uint8_t i = 0; i < 2; ++i) {
+      lo[i] = min(lo[i], lp[i]);
+      hi[i] = max(hi[i], lp[i]);
+    }
+    if (samples < 0xFFFF) samples++;
+
+    float cx = centre[0];
+    float cy = centre[1];
+    if (cx < lo[0] || cx > hi[0] || cy < lo[1] || cy > hi[1]) {
+      cx = (lo[0] + hi[0]) * 0.5f;
+      cy = (lo[1] + hi[1]) * 0.5f;
+    }
+    float dx = lp[0] - cx;
+    float dy = lp[1] - cy;
+    if (dx * dx + dy * dy >= MAG_CAL_MIN_RADIUS_UT * MAG_CAL_MIN_RADIUS_UT) {
+      uint8_t s = sectorOf(dx, dy);
+      if (secCount[s] < 0xFFFF) {
+        secSum[s][0] += lp[0];
+        secSum[s][1] += lp[1];
+        secCount[s]++;
+      }
+      sectorMask |= 1 << s;
+    }
+
+    MagCalibration c;
+    float radius;
+    if (millis() - sessionStart > MAG_CAL_SESSION_MS) {
+      // kein Vollkreis: mit besserem Mittelpunkt von vorn
+      if (computeFit(c, radius)) {
+        centre[0] = c.offset[0];
+        centre[1] = c.offset[1];
+      }
+      startSession();
+      return false;
+    }
+    if (sectorMask != ALL_SECTORS || samples < MAG_CAL_MIN_SAMPLES) return false;
+
+    bool ok = computeFit(c, radius);
+    MagFitQuality q = { SECTORS, ok ? spreadPct(c, radius) : (uint8_t)255, samples };
+    if (ok) {
+      centre[0] = c.offset[0];
+      centre[1] = c.offset[1];
+    }
+    startSession();
+    if (!ok || q.spreadPct > MAG_CAL_MAX_SPREAD_PCT) return false;
+
+    lastQuality = q;
+    if (!changedEnough(c, fit)) return false;
+    fit = c;
+    return true;
+  }
+
+  MagCalibration getFit() {
+    return fit;
+  }
+
+  MagFitQuality getQuality() {
+    MagFitQuality q = { sectorCount(), 255, samples };
+    MagCalibration c;
+    float radius;
+    if (samples > 0 && computeFit(c, radius)) q.spreadPct = spreadPct(c, radius);
+    return q;
+  }
+
+  MagFitQuality getLastFitQuality() {
+    return lastQuality;
+  }
+
+}
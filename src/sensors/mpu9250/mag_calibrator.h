@@ -0,0 +1,38 @@
+/*
+Rolle: Laufende Hard-/Soft-Iron-Kalibrierung des Magnetometers (X/Y).
+
+Inhalt:
+
+Pro Messwert (Board-Achsen, unkorrigiert, nur bei fast waagerechtem
+Gerät): Tiefpass, Min/Max je Achse, Zuordnung zu einem von zwölf
+30°-Kurssektoren und Mittelwert pro Sektor. Konstanter Speicher, konstante
+Zeit, kein atan2().
+
+Fit: Mittelpunkt = Mitte von Min/Max, Skalierung gleicht die halben
+Spannweiten von X und Y an. Z wird hier nicht bestimmt (dafür müsste das
+Gerät gekippt werden, siehe tools/calibration_scripts).
+
+Güte: Anzahl besuchter Sektoren und Streuung der Sektor-Mittelpunkte um
+den gefitteten Kreis. Eine Sitzung endet, wenn alle Sektoren besucht sind
+(Vollkreis gefahren); ist die Streuung klein genug, liefert addSample()
+true und getFit() den neuen Satz. Danach beginnt die nächste Sitzung, so
+folgt die Kalibrierung z. B. einem geänderten Rigg.
+*/
+
+#pragma once
+#include <stdint.h>
+#include "mpu9250_sensor.h"
+
+struct MagFitQuality {
+  uint8_t  sectors;      // besuchte 30°-Sektoren (12 = Vollkreis)
+  uint8_t  spreadPct;    // Abweichung der Sektor-Mittelpunkte vom Kreis, % des Radius
+  uint16_t samples;
+};
+
+namespace MagCalibrator {
+  void begin(const MagCalibration& current);   // neue Sitzung, X/Y-Startwerte aus current
+  bool addSample(float mx, float my);          // true = neuer Fit liegt bereit
+  MagCalibration getFit();                     // zuletzt angenommener Fit (Z unverändert)
+  MagFitQuality getQuality();                  // laufende Sitzung
+  MagFitQuality getLastFitQuality();           // zuletzt angenommener Fit
+}
@@ -13,4 +13,348 @@ Orientation: Roll, Pitch, Yaw
 ggf. Kompasswinkel
 
 Sensorfusion (Complementary Filter, Madgwick, Mahony …)
+
+
+Intern:
+
+MPU9250_WE, Initialisierung und Lageberechnung wie initIMU() /
+updateNavigation() aus code_test.
+
+Data-Ready-Interrupt (INT -> PIN_IMU_INT): der ISR liest nur die sechs
+Roh-Bytes der Beschleunigung und gibt sie an Knockdown::checkSample().
+Ist der I²C-Bus gerade vom Hauptprogramm belegt, wird das Lesen auf das
+nächste I2CBus::unlock() verschoben. Eingeschaltet wird er erst mit
+startDataReady() am Ende von systemInit(), nach allen anderen Treibern.
+
+Kalibrierung: Acc-/Gyro-Offsets (Einheiten der MPU9250_WE) und die
+Magnetometer-Korrektur liegen im Config-Store und werden beim Start
+sofort gesetzt. autoOffsets() (Gerät still und waagerecht) läuft nur,
+wenn noch nichts gespeichert ist oder auf Wunsch (requestCalibration()).
+Gyro-Drift wird im Stillstand (auch der Kurs steht) erkannt und
+nachgeführt. autoOffsets() verstellt Messbereiche und Filter, danach
+setzt configureRanges() die Werte aus begin() wieder. Die Acc-Offsets
+bleiben dabei unberührt, weil das Boot nicht waagerecht liegen muss.
+
+Magnetometer: Startwerte aus config.h (MAG_CAL_*), danach der Satz der
+Online-Kalibrierung (MagCalibrator, nur bei fast waagerechtem Gerät).
+Werden die Werte in config.h geändert, gilt der gespeicherte Satz nicht
+mehr. getIMU().mag* bleibt unkorrigiert (Log, Host-Fit), korrigiert wird
+nur für den Kurs.
 */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <MPU9250_WE.h>
+#include <util/crc16.h>
+#include "config.h"
+#include "config_store.h"
+#include "i2c_bus.h"
+#include "input_recorder.h"
+#include "knockdown.h"
+#include "mag_calibrator.h"
+#include "mpu9250_sensor.h"
+
+namespace {
+
+  MPU9250_WE imu(MPU9250_ADDR);
+  uint8_t imuAddr = MPU9250_ADDR;   // aus der Geräte-Tabelle, siehe begin()
+  IMUData data = {};
+  float headingDeg = 0.0f;
+
+  constexpr uint8_t REG_ACCEL_XOUT_H = 0x3B;
+
+  // Gyro-Offsets der Lib sind Rohwerte bei ±250 °/s
+  constexpr float GYRO_OFFSET_PER_DPS = 32768.0f / 250.0f;
+
+  constexpr uint8_t IMU_CAL_VERSION = 1;
+
+  enum class CalSource : uint8_t { FirstBoot, User, Drift };
+
+  struct ImuCalibration {
+    uint8_t  version;
+    uint8_t  source;          // CalSource der letzten Änderung
+    uint16_t driftFixes;      // Gyro-Nachführungen seit autoOffsets()
+    xyzFloat accOffset;
+    xyzFloat gyrOffset;
+  };
+
+  // gespeicherter Satz gehört zu diesen config.h-Werten
+  struct StoredMagCalibration {
+    MagCalibration cal;
+    uint16_t defaultsId;
+  };
+
+  ImuCalibration cal = {};
+  MagCalibration magCal;
+  bool calRequested = false;
+  bool present = false;             // begin() erfolgreich
+
+  // Stillstandsfenster für die Drifterkennung
+  unsigned long stillSince = 0;
+  uint16_t stillCount = 0;
+  xyzFloat gyrSum, gyrMin, gyrMax;
+  float stillHeading = 0.0f;        // Kurs zu Beginn des Fensters
+
+  volatile bool sampling = false;   // Schutz gegen Wiedereintritt nach sei()
+
+  // Liest ACCEL_XOUT..ACCEL_ZOUT (big endian) und setzt damit gleichzeitig
+  // den gelatchten INT-Pin zurück (clear on any read).
+  void readAccelAndCheck() {
+    Wire.beginTransmission(imuAddr);
+    Wire.write(REG_ACCEL_XOUT_H);
+    if (Wire.endTransmission(false) != 0) return;
+    if (Wire.requestFrom(imuAddr, (uint8_t)6) != 6) return;
+
+    uint8_t b[6];
+    for (uint8_t i = 0; i < 6; ++i) b[i] = Wire.read();
+    int16_t chipX = (int16_t)((b[0] << 8) | b[1]);
+    int16_t chipZ = (int16_t)((b[4] << 8) | b[5]);
+
+    // Achsen wie updateNavigation(): Chip-X zeigt nach rechts (quer), Z nach oben
+    InputRecorder::recordKnock(chipX, chipZ);
+    Knockdown::checkSample(chipX, chipZ);
+  }
+
+  void onDataReady() {
+    if (sampling) return;
+    if (I2CBus::isLocked()) {
+      I2CBus::deferUntilUnlock(readAccelAndCheck);
+      return;
+    }
+    sampling = true;
+    // Wire arbeitet selbst mit dem TWI-Interrupt
+    interrupts();
+    readAccelAndCheck();
+    noInterrupts();
+    sampling = false;
+  }
+
+  uint16_t magDefaultsId() {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(MAG_CAL_OFFSET);
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < sizeof(MAG_CAL_OFFSET); ++i) crc = _crc_ccitt_update(crc, p[i]);
+    p = reinterpret_cast<const uint8_t*>(MAG_CAL_SCALE);
+    for (uint8_t i = 0; i < sizeof(MAG_CAL_SCALE); ++i) crc = _crc_ccitt_update(crc, p[i]);
+    return crc;
+  }
+
+  // Messbereiche und Filter; autoOffsets() stellt selbst auf 2 g / 250 °/s
+  // und DLPF 6 um, danach muss das hier erneut gesetzt werden.
+  // 1 kHz / (1 + 9) = 100 Hz Data-Ready
+  void configureRanges() {
+    imu.setAccRange(MPU9250_ACC_RANGE_8G);
+    imu.setGyrRange(MPU9250_GYRO_RANGE_500);
+    imu.enableAccDLPF(true);
+    imu.setAccDLPF(MPU9250_DLPF_3);
+    imu.enableGyrDLPF();
+    imu.setGyrDLPF(MPU9250_DLPF_3);
+    imu.setSampleRateDivider(9);
+  }
+
+  void runAutoOffsets(CalSource source) {
+    I2CBus::lock();
+    imu.autoOffsets();
+    cal.accOffset = imu.getAccOffsets();
+    cal.gyrOffset = imu.getGyrOffsets();
+    configureRanges();
+    I2CBus::unlock();
+    cal.version = IMU_CAL_VERSION;
+    cal.source = static_cast<uint8_t>(source);
+    cal.driftFixes = 0;
+    ConfigStore::set(ConfigKey::ImuOffsets, &cal, sizeof(cal));
+  }
+
+  void resetStill() {
+    stillCount = 0;
+    gyrSum = { 0, 0, 0 };
+  }
+
+  float headingDiff(float a, float b) {
+    float d = fmod(a - b + 540.0f, 360.0f) - 180.0f;
+    return fabs(d);
+  }
+
+  // Im Stillstand zeigt der Gyro nur seinen Offset-Fehler. Eine gleichmäßige
+  // Drehung (Schwojen am Anker) sieht für Acc und Gyro-Streuung genauso aus,
+  // verrät sich aber am Kompasskurs.
+  void checkGyroDrift(const xyzFloat& acc, const xyzFloat& gyr, float heading) {
+    float g = sqrt(acc.x * acc.x + acc.y * acc.y + acc.z * acc.z);
+    if (fabs(g - 1.0f) > IMU_STILL_ACC_G) {
+      resetStill();
+      return;
+    }
+    if (stillCount == 0) {
+      stillSince = millis();
+      gyrMin = gyr;
+      gyrMax = gyr;
+      stillHeading = heading;
+    }
+    gyrMin = { min(gyrMin.x, gyr.x), min(gyrMin.y, gyr.y), min(gyrMin.z, gyr.z) };
+    gyrMax = { max(gyrMax.x, gyr.x), max(gyrMax.y, gyr.y), max(gyrMax.z, gyr.z) };
+    if (gyrMax.x - gyrMin.x > IMU_STILL_GYRO_DPS || gyrMax.y - gyrMin.y > IMU_STILL_GYRO_DPS
+        || gyrMax.z - gyrMin.z > IMU_STILL_GYRO_DPS
+        || headingDiff(heading, stillHeading) > IMU_STILL_HEADING_DEG) {
+      resetStill();
+      return;
+    }
+    gyrSum = { gyrSum.x + gyr.x, gyrSum.y + gyr.y, gyrSum.z + gyr.z };
+    if (stillCount < 0xFFFF) stillCount++;
+    if (millis() - stillSince < IMU_DRIFT_WINDOW_MS) return;
+
+    xyzFloat mean = { gyrSum.x / stillCount, gyrSum.y / stillCount, gyrSum.z / stillCount };
+    resetStill();
+    if (fabs(mean.x) < IMU_GYRO_DRIFT_DPS && fabs(mean.y) < IMU_GYRO_DRIFT_DPS
+        && fabs(mean.z) < IMU_GYRO_DRIFT_DPS) {
+      return;
+    }
+    // so viel Drift hat kein Offset-Fehler, das war doch eine Drehung
+    if (fabs(mean.x) > IMU_GYRO_DRIFT_MAX_DPS || fabs(mean.y) > IMU_GYRO_DRIFT_MAX_DPS
+        || fabs(mean.z) > IMU_GYRO_DRIFT_MAX_DPS) {
+      return;
+    }
+
+    cal.gyrOffset.x += mean.x * GYRO_OFFSET_PER_DPS;
+    cal.gyrOffset.y += mean.y * GYRO_OFFSET_PER_DPS;
+    cal.gyrOffset.z += mean.z * GYRO_OFFSET_PER_DPS;
+    cal.source = static_cast<uint8_t>(CalSource::Drift);
+    cal.driftFixes++;
+    imu.setGyrOffsets(cal.gyrOffset);
+    ConfigStore::set(ConfigKey::ImuOffsets, &cal, sizeof(cal));
+  }
+
+}
+
+namespace MPU9250Module {
+
+  bool begin() {
+    imuAddr = I2CBus::address(I2CDevice::Imu);
+    if (imuAddr == I2C_NO_DEVICE) return false;
+    if (imuAddr != MPU9250_ADDR) imu = MPU9250_WE(imuAddr);
+    if (!imu.init()) return false;
+
+    configureRanges();
+    imu.initMagnetometer();
+    imu.setMagOpMode(AK8963_CONT_MODE_100HZ);
+    delay(100);
+
+    if (ConfigStore::get(ConfigKey::ImuOffsets, &cal, sizeof(cal)) && cal.version == IMU_CAL_VERSION) {
+      imu.setAccOffsets(cal.accOffset);
+      imu.setGyrOffsets(cal.gyrOffset);
+    } else {
+      runAutoOffsets(CalSource::FirstBoot);
+    }
+    StoredMagCalibration stored;
+    if (ConfigStore::get(ConfigKey::MagCalibration, &stored, sizeof(stored))
+        && stored.defaultsId == magDefaultsId()) {
+      magCal = stored.cal;
+    } else {
+      memcpy(magCal.offset, MAG_CAL_OFFSET, sizeof(magCal.offset));
+      memcpy(magCal.scale, MAG_CAL_SCALE, sizeof(magCal.scale));
+    }
+    MagCalibrator::begin(magCal);
+    calRequested = false;
+    resetStill();
+
+    Knockdown::begin(KNOCKDOWN_HEEL_DEG);
+
+    imu.setIntPinPolarity(MPU9250_ACT_HIGH);
+    imu.enableIntLatch(true);
+    imu.enableClearIntByAnyRead(true);
+    present = true;
+    return true;
+  }
+
+  void startDataReady() {
+    if (!present) return;
+    // erst den ISR anhängen: ein INT, der vorher kommt, bliebe gelatcht
+    // und es gäbe nie wieder eine steigende Flanke
+    pinMode(PIN_IMU_INT, INPUT);
+    attachInterrupt(digitalPinToInterrupt(PIN_IMU_INT), onDataReady, RISING);
+    I2CBus::lock();
+    imu.enableInterrupt(MPU9250_DATA_READY);
+    I2CBus::unlock();
+  }
+
+  void update() {
+    if (!present) return;
+    if (calRequested) {
+      calRequested = false;
+      runAutoOffsets(CalSource::User);
+      resetStill();
+    }
+
+    I2CBus::lock();
+    xyzFloat acc = imu.getGValues();
+    xyzFloat mag = imu.getMagValues();
+    xyzFloat gyr = imu.getGyrValues();
+    I2CBus::unlock();
+    InputRecorder::recordImu(acc.x, acc.y, acc.z, mag.x, mag.y, mag.z);
+
+    // Board-Aufdruck: Y zeigt nach vorne, X nach rechts
+    float Ax = acc.y;
+    float Ay = acc.x;
+    float Az = acc.z;
+    float Mx = (mag.y - magCal.offset[0]) * magCal.scale[0];
+    float My = (mag.x - magCal.offset[1]) * magCal.scale[1];
+    float Mz = (mag.z - magCal.offset[2]) * magCal.scale[2];
+
+    float roll  = atan2(Ay, Az);
+    float pitch = atan2(-Ax, sqrt(Ay * Ay + Az * Az));
+
+    constexpr float MAX_TILT = MAG_CAL_MAX_TILT_DEG * PI / 180.0f;
+    if (fabs(roll) < MAX_TILT && fabs(pitch) < MAX_TILT && MagCalibrator::addSample(mag.y, mag.x)) {
+      setMagCalibration(MagCalibrator::getFit());
+    }
+
+    float cosRoll  = cos(roll);
+    float sinRoll  = sin(roll);
+    float cosPitch = cos(pitch);
+    float sinPitch = sin(pitch);
+
+    float Xh = Mx * cosPitch + Mz * sinPitch;
+    float Yh = Mx * sinRoll * sinPitch + My * cosRoll - Mz * sinRoll * cosPitch;
+
+    headingDeg = atan2(Yh, Xh) * 180.0f / PI;
+    if (headingDeg < 0) headingDeg += 360.0f;
+    checkGyroDrift(acc, gyr, headingDeg);
+
+    data.roll  = roll  * 180.0f / PI;
+    data.pitch = pitch * 180.0f / PI;
+    data.yaw   = headingDeg;
+    data.magX  = mag.y;
+    data.magY  = mag.x;
+    data.magZ  = mag.z;
+  }
+
+  bool isPresent() {
+    return present;
+  }
+
+  IMUData getIMU() {
+    return data;
+  }
+
+  float getHeadingDeg() {
+    return headingDeg;
+  }
+
+  void requestCalibration() {
+    calRequested = true;
+  }
+
+  bool isCalibrationPending() {
+    return calRequested;
+  }
+
+  MagCalibration getMagCalibration() {
+    return magCal;
+  }
+
+  void setMagCalibration(const MagCalibration& c) {
+    magCal = c;
+    StoredMagCalibration stored = { magCal, magDefaultsId() };
+    ConfigStore::set(ConfigKey::MagCalibration, &stored, sizeof(stored));
+    MagCalibrator::begin(magCal);
+  }
+
+}
@@ -25,9 +25,26 @@ Der Code ist viel cleaner als getrennte Sensoren.
 #pragma once
 #include "types.h"
 
+// Magnetometer-Korrektur in Board-Achsen: m' = (m - offset) * scale
+struct MagCalibration {
+    float offset[3];     // Hard-Iron (µT)
+    float scale[3];      // Soft-Iron, Skalierung je Achse
+};
+
 namespace MPU9250Module {
-    bool begin();
+    bool begin();            // Offsets aus dem Config-Store, sonst einmal autoOffsets()
+    // Data-Ready-ISR (liest über Wire) erst, wenn alle anderen I2C-Treiber
+    // gestartet sind: deren begin() sperrt den Bus nicht mit I2CBus::lock()
+    void startDataReady();
+    bool isPresent();        // begin() hat den IMU gefunden
     void update();
     IMUData getIMU();
     float getHeadingDeg();   // magnetischer Kurs
+
+    // Acc/Gyro neu kalibrieren (beim nächsten update(), Gerät still und waagerecht)
+    void requestCalibration();
+    bool isCalibrationPending();
+
+    MagCalibration getMagCalibration();
+    void setMagCalibration(const MagCalibration& cal);   // anwenden, speichern, Online-Fit neu starten
 }
@@ -3,9 +3,378 @@ Rolle: Echtzeituhr.
 
 Inhalt:
 
-Wrapper um RTC-Library (DS3231/DS1307)
+Zwei Taktquellen für die Software-Uhr:
 
-getTime(), setTime(), evtl. getUnixTime()
+1. SQW (Standard): Der DS3231 gibt an PIN_RTC_SQW 1 Hz aus. Jede fallende
+   Flanke (= Sekundenwechsel im DS3231) zählt im ISR sqwTicks hoch und
+   merkt sich millis(). Zeit = sqwBase + sqwTicks, Bruchteil = millis()
+   seit der Flanke. Per I²C wird nur beim Start, alle RTC_SQW_RESYNC_MS
+   und nach dem Stellen gelesen.
 
-Abstraktion, damit der Rest des Codes keine RTC-Library direkt kennt
+2. millis() (Rückfall, wenn keine Flanken kommen): baseEpoch gilt zum
+   Zeitpunkt baseMs, korrigiert um den geschätzten Gangfehler des
+   Arduino-Quarzes (swRatePpm). Spätestens nach RESYNC_INTERVAL_MS wird die
+   Basis neu gesetzt, damit die Rechnung in 32 Bit bleibt.
+
+DS3231-Drift gegen GPS: Abweichung DS3231 - GPS in ms (mit SQW
+millisekundengenau über die Phase der Flanke, sonst nur ganze Sekunden).
+Die Änderung seit dem Referenzpunkt über mindestens RTC_DRIFT_MIN_SPAN_S
+ergibt die Drift in ppm.
+
+Aging-Offset (Register 0x10, Zweierkomplement): +1 LSB verlangsamt den
+Oszillator um ca. 0,1 ppm. Geht die Uhr vor, wird der Wert erhöht.
+
+Kalenderfelder: update() holt einmal die Epoch. Bleibt der Tag gleich,
+werden nur Stunde/Minute/Sekunde aus der Sekunde des Tages abgeleitet;
+Datum, Wochentag und Tag im Jahr erst beim Tageswechsel (oder Sprung).
 */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <RTClib.h>
+#include "config.h"
+#include "i2c_bus.h"
+#include "input_recorder.h"
+#include "time_utils.h"
+#include "rtc_module.h"
+
+namespace {
+
+  RTC_DS3231 rtc;
+  bool rtcPresent = false;
+
+  constexpr uint8_t DS3231_ADDR       = 0x68;
+  constexpr uint8_t DS3231_REG_AGING  = 0x10;
+  constexpr float   AGING_PPM_PER_LSB = 0.1f;
+  constexpr int32_t MAX_SW_RATE_PPM   = 500;
+
+  constexpr unsigned long RESYNC_INTERVAL_MS = 10UL * 60UL * 1000UL;
+  constexpr unsigned long GPS_HOLDOVER_MS    = 60UL * 60UL * 1000UL;
+  constexpr unsigned long SQW_TIMEOUT_MS     = 2500;   // so lange ohne Flanke -> Rückfall
+  constexpr int32_t  SW_MAX_ERROR_MS    = 250;
+  constexpr uint32_t SW_RATE_MIN_SPAN_S = 600;
+
+  // SQW-Uhr
+  volatile uint32_t sqwTicks  = 0;
+  volatile uint32_t sqwEdgeMs = 0;
+  bool     sqwActive = false;     // sqwBase ist gültig, Flanken kommen
+  uint32_t sqwBase   = 0;         // Epoch bei sqwTicks == 0
+  int32_t  gpsOffsetS = 0;        // GPS - DS3231 in ganzen Sekunden
+  uint32_t lastSqwSyncMs = 0;
+
+  // millis()-Uhr
+  uint32_t baseEpoch = 0;
+  uint32_t baseMs    = 0;
+  int32_t  swRatePpm = 0;         // + = millis() läuft zu schnell
+  bool     gpsLocked = false;     // Basis stammt vom GPS
+  uint32_t lastGpsMs = 0;
+  uint32_t lastGpsAnchorEpoch = 0;
+
+  // DS3231-Drift
+  bool     driftRefValid = false;
+  uint32_t driftRefEpoch = 0;
+  int32_t  driftRefErrMs = 0;
+  uint32_t lastRtcCheckEpoch = 0;
+  int8_t   aging = 0;
+  float    driftPpm = 0.0f;
+
+  // Zwischengespeicherte Zeit für alle Verbraucher
+  uint32_t cachedEpoch = 0;
+  uint32_t cachedDay   = 0xFFFFFFFFUL;
+  DateTimeSimple fields = {};
+  uint8_t  changes = 0;
+
+  void onSqw() {
+    sqwTicks++;
+    sqwEdgeMs = millis();
+  }
+
+  uint32_t readRtcEpoch() {
+    I2CBus::lock();
+    uint32_t t = rtc.now().unixtime();
+    I2CBus::unlock();
+    return t;
+  }
+
+  int8_t readAging() {
+    I2CBus::lock();
+    Wire.beginTransmission(DS3231_ADDR);
+    Wire.write(DS3231_REG_AGING);
+    Wire.endTransmission();
+    Wire.requestFrom(DS3231_ADDR, (uint8_t)1);
+    int8_t v = (int8_t)Wire.read();
+    I2CBus::unlock();
+    return v;
+  }
+
+  void writeAging(int8_t v) {
+    I2CBus::lock();
+    Wire.beginTransmission(DS3231_ADDR);
+    Wire.write(DS3231_REG_AGING);
+    Wire.write((uint8_t)v);
+    Wire.endTransmission();
+    I2CBus::unlock();
+  }
+
+  void readSqw(uint32_t& ticks, uint32_t& edgeMs) {
+    noInterrupts();
+    ticks = sqwTicks;
+    edgeMs = sqwEdgeMs;
+    interrupts();
+  }
+
+  // DS3231 lesen und sqwBase so setzen, dass sqwBase + sqwTicks stimmt.
+  // Fällt während des Lesens eine Flanke, passt der Wert nicht sicher zum
+  // Zählerstand -> nochmal.
+  bool syncSqw() {
+    for (uint8_t attempt = 0; attempt < 2; ++attempt) {
+      uint32_t before, after, edgeMs;
+      readSqw(before, edgeMs);
+      uint32_t epoch = readRtcEpoch();
+      readSqw(after, edgeMs);
+      if (before == after) {
+        sqwBase = epoch - after;
+        lastSqwSyncMs = millis();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // korrigierte Millisekunden seit baseMs
+  uint32_t elapsedMs(uint32_t nowMs) {
+    int32_t e = (int32_t)(nowMs - baseMs);
+    return (uint32_t)(e - e / 1000 * swRatePpm / 1000);
+  }
+
+  uint32_t swEpoch(uint32_t nowMs) {
+    return baseEpoch + elapsedMs(nowMs) / 1000;
+  }
+
+  void anchor(uint32_t epoch, uint32_t atMs) {
+    baseEpoch = epoch;
+    baseMs = atMs;
+  }
+
+  // Basis auf die letzte volle Sekunde vorziehen, ohne Zeit zu verlieren
+  void fold(uint32_t nowMs) {
+    uint32_t secs = elapsedMs(nowMs) / 1000;
+    uint32_t rawMs = secs * 1000;
+    rawMs += (int32_t)rawMs / 1000 * swRatePpm / 1000;
+    baseEpoch += secs;
+    baseMs += rawMs;
+  }
+
+  // errMs = DS3231 - GPS zum Zeitpunkt gpsEpoch
+  void checkRtc(uint32_t gpsEpoch, int32_t errMs, uint32_t secondStartMs) {
+    if (!driftRefValid) {
+      driftRefValid = true;
+      driftRefEpoch = gpsEpoch;
+      driftRefErrMs = errMs;
+    } else {
+      uint32_t span = gpsEpoch - driftRefEpoch;
+      int32_t delta = errMs - driftRefErrMs;
+      if (span >= RTC_DRIFT_MIN_SPAN_S && delta != 0) {
+        driftPpm = delta * 1000.0f / span;
+        int16_t next = aging + (int16_t)lroundf(driftPpm / AGING_PPM_PER_LSB);
+        next = constrain(next, -128, 127);
+        if (next != aging) {
+          aging = (int8_t)next;
+          writeAging(aging);
+        }
+        driftRefEpoch = gpsEpoch;
+        driftRefErrMs = errMs;
+      }
+    }
+
+    if (abs(errMs) > RTC_MAX_ERROR_S * 1000L) {
+      // Schreiben der Sekunden startet den Teiler im DS3231 neu; die
+      // nächste Flanke kommt also 1 s nach dem Schreiben
+      uint32_t nowEpoch = gpsEpoch + (millis() - secondStartMs) / 1000;
+      I2CBus::lock();
+      rtc.adjust(DateTime(nowEpoch));
+      I2CBus::unlock();
+      gpsOffsetS = 0;
+      if (sqwActive) syncSqw();
+      // Drift wird ab hier neu gemessen
+      driftRefValid = false;
+    }
+  }
+
+  void disciplineMillis(uint32_t gpsEpoch, uint32_t secondStartMs) {
+    // Software-Uhr: erst ab SW_MAX_ERROR_MS Abweichung neu setzen (die
+    // Ankunft des RMC schwankt um einige 10 ms), die Abweichung seit dem
+    // letzten GPS-Anker ergibt den Gangfehler von millis()
+    if (!gpsLocked) {
+      anchor(gpsEpoch, secondStartMs);
+      gpsLocked = true;
+      lastGpsAnchorEpoch = gpsEpoch;
+      return;
+    }
+    int32_t expectedMs = (int32_t)(gpsEpoch - baseEpoch) * 1000L;
+    int32_t errMs = (int32_t)elapsedMs(secondStartMs) - expectedMs;
+    if (abs(errMs) >= SW_MAX_ERROR_MS) {
+      uint32_t span = gpsEpoch - lastGpsAnchorEpoch;
+      if (span >= SW_RATE_MIN_SPAN_S) {
+        int32_t ppm = swRatePpm + errMs * 1000L / (int32_t)span;
+        swRatePpm = constrain(ppm, -MAX_SW_RATE_PPM, MAX_SW_RATE_PPM);
+      }
+      anchor(gpsEpoch, secondStartMs);
+      lastGpsAnchorEpoch = gpsEpoch;
+    }
+  }
+
+  void updateClock() {
+    uint32_t nowMs = millis();
+    if (gpsLocked && nowMs - lastGpsMs > GPS_HOLDOVER_MS) gpsLocked = false;
+
+    if (rtcPresent) {
+      uint32_t ticks, edgeMs;
+      readSqw(ticks, edgeMs);
+      bool edgesRunning = ticks > 0 && nowMs - edgeMs < SQW_TIMEOUT_MS;
+
+      if (sqwActive && !edgesRunning) {
+        // SQW ausgefallen: millis()-Uhr ab der letzten bekannten Zeit
+        anchor(sqwBase + ticks + gpsOffsetS, edgeMs);
+        sqwActive = false;
+      } else if (!sqwActive && edgesRunning) {
+        sqwActive = syncSqw();
+      } else if (sqwActive && nowMs - lastSqwSyncMs >= RTC_SQW_RESYNC_MS) {
+        syncSqw();
+      }
+      if (sqwActive) return;
+    }
+
+    if (nowMs - baseMs < RESYNC_INTERVAL_MS) return;
+
+    // Ohne GPS ist der DS3231 die bessere Quelle als millis()
+    if (rtcPresent && !gpsLocked) {
+      anchor(readRtcEpoch(), nowMs);
+    } else {
+      fold(nowMs);
+    }
+  }
+
+  uint32_t currentEpoch() {
+    if (sqwActive) {
+      noInterrupts();
+      uint32_t ticks = sqwTicks;
+      interrupts();
+      return sqwBase + ticks + gpsOffsetS;
+    }
+    return swEpoch(millis());
+  }
+
+  void refreshFields(uint32_t epoch) {
+    if (epoch == cachedEpoch && cachedDay != 0xFFFFFFFFUL) {
+      changes = 0;
+      return;
+    }
+
+    uint32_t day = epoch / TimeUtils::SECONDS_PER_DAY;
+    uint32_t sod = epoch - day * TimeUtils::SECONDS_PER_DAY;
+    uint8_t hour   = sod / 3600;
+    uint8_t minute = (sod / 60) % 60;
+
+    changes = TIME_CHANGED_SECOND;
+    if (minute != fields.minute || hour != fields.hour || day != cachedDay) changes |= TIME_CHANGED_MINUTE;
+    if (hour != fields.hour || day != cachedDay) changes |= TIME_CHANGED_HOUR;
+
+    if (day != cachedDay) {
+      changes |= TIME_CHANGED_DAY;
+      TimeUtils::civilFromDays(day, fields.year, fields.month, fields.day);
+      fields.weekday = TimeUtils::weekday(day);
+      fields.yearDay = TimeUtils::dayOfYear(fields.year, fields.month, fields.day);
+      cachedDay = day;
+    }
+    fields.hour   = hour;
+    fields.minute = minute;
+    fields.second = sod % 60;
+    cachedEpoch = epoch;
+  }
+
+}
+
+namespace RTCModule {
+
+  bool begin() {
+    // RTClib kennt nur 0x68; fehlt das RTC laut Geräte-Tabelle, gar nicht erst fragen
+    rtcPresent = I2CBus::address(I2CDevice::Rtc) != I2C_NO_DEVICE && rtc.begin();
+    if (!rtcPresent) return false;
+
+    if (rtc.lostPower()) {
+      // Ohne gültige Zeit wenigstens die Compile-Zeit; GPS stellt nach
+      rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
+    }
+    aging = readAging();
+    anchor(readRtcEpoch(), millis());
+
+    rtc.writeSqwPinMode(DS3231_SquareWave1Hz);
+    pinMode(PIN_RTC_SQW, INPUT_PULLUP);          // SQW ist Open-Drain
+    attachInterrupt(digitalPinToInterrupt(PIN_RTC_SQW), onSqw, FALLING);
+    refreshFields(currentEpoch());
+    return true;
+  }
+
+  void update() {
+    updateClock();
+    refreshFields(currentEpoch());
+    if (changes & TIME_CHANGED_SECOND) InputRecorder::recordClock(cachedEpoch);
+  }
+
+  void discipline(const GPSData& gps, uint32_t fixMs) {
+    if (!gps.timeValid || !gps.dateValid) return;
+
+    uint32_t gpsEpoch = TimeUtils::toEpoch(gps.year, gps.month, gps.day,
+                                           gps.hour, gps.minute, gps.second);
+    uint32_t secondStartMs = fixMs - gps.centisecond * 10UL;
+    lastGpsMs = fixMs;
+
+    int32_t errMs = 0;
+    if (sqwActive) {
+      // DS3231-Zeit zum Zeitpunkt secondStartMs, aus Zählerstand und Phase
+      uint32_t ticks, edgeMs;
+      readSqw(ticks, edgeMs);
+      errMs = (int32_t)(sqwBase + ticks - gpsEpoch) * 1000L
+            + (int32_t)(secondStartMs - edgeMs);
+      gpsOffsetS = -(errMs >= 0 ? (errMs + 500) / 1000 : (errMs - 500) / 1000);
+    } else {
+      disciplineMillis(gpsEpoch, secondStartMs);
+    }
+
+    if (rtcPresent && gpsEpoch - lastRtcCheckEpoch >= RTC_CHECK_INTERVAL_S) {
+      lastRtcCheckEpoch = gpsEpoch;
+      if (!sqwActive) errMs = (int32_t)(readRtcEpoch() - gpsEpoch) * 1000L;
+      checkRtc(gpsEpoch, errMs, secondStartMs);
+    }
+  }
+
+  uint32_t getUnixTime() {
+    return cachedEpoch;
+  }
+
+  const DateTimeSimple& getFields() {
+    return fields;
+  }
+
+  uint8_t getChanges() {
+    return changes;
+  }
+
+  uint16_t getBucketIndex(uint32_t bucketSeconds, uint16_t count) {
+    return TimeUtils::bucketIndex(cachedEpoch, bucketSeconds, count);
+  }
+
+  DateTimeSimple now() {
+    return fields;
+  }
+
+  int8_t getAgingOffset() {
+    return aging;
+  }
+
+  float getDriftPpm() {
+    return driftPpm;
+  }
+
+}
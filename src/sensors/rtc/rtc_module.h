@@ -8,16 +8,51 @@ Wrapper um RTC-Library (DS3231/DS1307)
 getTime(), setTime(), evtl. getUnixTime()
 
 Abstraktion, damit der Rest des Codes keine RTC-Library direkt kennt
+
+Uhrzeitabfragen kommen aus einer Software-Uhr (millis() + Basis),
+nicht per I²C. Die Basis kommt beim Start aus dem DS3231 und wird
+danach vom GPS (UTC) nachgeführt.
+
+Drift des DS3231 gegen GPS wird über lange Zeit geschätzt und über das
+Aging-Offset-Register korrigiert. Der DS3231 wird nur neu gestellt, wenn
+er mehr als RTC_MAX_ERROR_S danebenliegt.
 */
 
+#pragma once
+#include <stdint.h>
+#include "nmea_parser.h"
+
 struct DateTimeSimple {
   uint16_t year;
   uint8_t  month, day, hour, minute, second;
+  uint8_t  weekday;              // 0 = Sonntag
+  uint16_t yearDay;              // 1..366
 };
 
+// Bits für RTCModule::getChanges()
+constexpr uint8_t TIME_CHANGED_SECOND = 0x01;
+constexpr uint8_t TIME_CHANGED_MINUTE = 0x02;
+constexpr uint8_t TIME_CHANGED_HOUR   = 0x04;
+constexpr uint8_t TIME_CHANGED_DAY    = 0x08;
+
 namespace RTCModule {
   bool begin();
-  DateTimeSimple now();
+  void update();                 // in jeder loop()-Runde, liest selten per I²C
+  DateTimeSimple now();          // Kopie der zwischengespeicherten Felder
+  uint32_t getUnixTime();        // Epoch, wie beim letzten update()
+
+  // Kalenderfelder werden nur bei einem Wechsel der Sekunde nachgeführt,
+  // das Datum nur beim Tageswechsel neu berechnet
+  const DateTimeSimple& getFields();
+  // Welche Felder sich beim letzten update() geändert haben (TIME_CHANGED_*),
+  // damit Verbraucher nicht selbst alte Werte vergleichen müssen
+  uint8_t getChanges();
+  // Stunde des Tages o. Ä. aus der Epoch, siehe TimeUtils::bucketIndex
+  uint16_t getBucketIndex(uint32_t bucketSeconds, uint16_t count);
+
+  // Mit jedem neuen gültigen RMC aufrufen; fixMs = millis() beim Empfang
+  void discipline(const GPSData& gps, uint32_t fixMs);
+
+  int8_t getAgingOffset();       // aktuell im DS3231 eingestellt (0,1 ppm/LSB)
+  float  getDriftPpm();          // letzte Driftschätzung, + = DS3231 geht vor
 }
-
-
@@ -3,11 +3,148 @@ Rolle: Verwaltung der 4 Taster.
 
 Inhalt:
 
-Pin-Definitionen (oder inkl. config.h)
+Pin-Change-Interrupts (PCINT) erfassen jede Flanke sofort,
+unabhängig vom Loop-/Render-Takt
 
-Entprellung
+Entprellung über Zeitstempel: nach einer übernommenen Flanke werden
+weitere Flanken BUTTON_DEBOUNCE_MS lang ignoriert
 
-Erkennung von Klick, Long-Press, Repeat
+ShortPress wird beim Loslassen direkt aus dem ISR in die Queue gelegt,
+LongPress und Repeat erzeugt update()
 
-Event-Interface für Menüsystem
+Event-Queue: fester Ringpuffer, ein Schreiber (ISR bzw. update() mit
+gesperrten Interrupts), ein Leser (getNextEvent()), ohne Locks
 */
+
+#include <Arduino.h>
+#include "config.h"
+#include "buttons.h"
+
+namespace {
+
+  struct ButtonState {
+    volatile uint8_t* inReg;         // PINx-Register
+    uint8_t mask;
+    bool hasPcint;
+
+    volatile bool pressed;           // entprellter Zustand
+    volatile bool longFired;         // LongPress schon gemeldet -> kein ShortPress beim Loslassen
+    volatile unsigned long edgeTime; // letzte übernommene Flanke
+    volatile unsigned long pressTime;
+    unsigned long nextRepeat;
+  };
+
+  ButtonState buttons[BUTTON_COUNT];
+
+  constexpr uint8_t QUEUE_SIZE = 8;   // Zweierpotenz
+  ButtonEvent queue[QUEUE_SIZE];
+  volatile uint8_t queueHead = 0;     // nur vom Schreiber geändert
+  volatile uint8_t queueTail = 0;     // nur vom Leser geändert
+
+  // Darf nur mit gesperrten Interrupts bzw. aus dem ISR aufgerufen werden.
+  void pushEvent(uint8_t index, ButtonEventType type, unsigned long t) {
+    uint8_t next = (queueHead + 1) & (QUEUE_SIZE - 1);
+    if (next == queueTail) return;    // voll -> Event verwerfen statt überschreiben
+    queue[queueHead].buttonId = index + 1;
+    queue[queueHead].type = type;
+    queue[queueHead].timeMs = t;
+    queueHead = next;
+  }
+
+  void sample(uint8_t i, unsigned long now) {
+    ButtonState& b = buttons[i];
+    bool level = !(*b.inReg & b.mask);   // active low
+    if (level == b.pressed) return;
+    if (now - b.edgeTime < BUTTON_DEBOUNCE_MS) return;
+
+    b.pressed = level;
+    b.edgeTime = now;
+    if (level) {
+      b.pressTime = now;
+      b.longFired = false;
+    } else if (!b.longFired) {
+      pushEvent(i, ButtonEventType::ShortPress, b.pressTime);
+    }
+  }
+
+  void sampleAll() {
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < BUTTON_COUNT; ++i) {
+      sample(i, now);
+    }
+  }
+
+}
+
+// Alle drei PCINT-Gruppen landen im selben Handler; Abtasten aller
+// Taster ist billiger als herauszufinden, welcher Pin gewechselt hat.
+ISR(PCINT0_vect) { sampleAll(); }
+ISR(PCINT1_vect) { sampleAll(); }
+ISR(PCINT2_vect) { sampleAll(); }
+
+namespace Buttons {
+
+  void begin() {
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < BUTTON_COUNT; ++i) {
+      uint8_t pin = BUTTON_PINS[i];
+      pinMode(pin, INPUT_PULLUP);
+
+      ButtonState& b = buttons[i];
+      b.inReg = portInputRegister(digitalPinToPort(pin));
+      b.mask = digitalPinToBitMask(pin);
+      b.pressed = false;
+      b.longFired = false;
+      b.edgeTime = now;
+      b.pressTime = now;
+
+      volatile uint8_t* pcicr = digitalPinToPCICR(pin);
+      b.hasPcint = (pcicr != 0);
+      if (b.hasPcint) {
+        *digitalPinToPCMSK(pin) |= _BV(digitalPinToPCMSKbit(pin));
+        *pcicr |= _BV(digitalPinToPCICRbit(pin));
+      }
+    }
+  }
+
+  void update() {
+    unsigned long now = millis();
+
+    noInterrupts();
+    // Fängt eine Flanke auf, die im Entprellfenster endete (und Pins ohne
+    // PCINT, falls BUTTON_PINS so belegt wird).
+    for (uint8_t i = 0; i < BUTTON_COUNT; ++i) {
+      sample(i, now);
+    }
+
+    for (uint8_t i = 0; i < BUTTON_COUNT; ++i) {
+      ButtonState& b = buttons[i];
+      if (!b.pressed) continue;
+
+      unsigned long held = now - b.pressTime;
+      if (!b.longFired) {
+        if (held >= BUTTON_LONG_MS) {
+          b.longFired = true;
+          b.nextRepeat = now + BUTTON_REPEAT_MS;
+          pushEvent(i, ButtonEventType::LongPress, now);
+        }
+      } else if ((long)(now - b.nextRepeat) >= 0) {
+        b.nextRepeat += BUTTON_REPEAT_MS;
+        pushEvent(i, ButtonEventType::Repeat, now);
+      }
+    }
+    interrupts();
+  }
+
+  bool getNextEvent(ButtonEvent& ev) {
+    uint8_t tail = queueTail;
+    if (tail == queueHead) {
+      ev.type = ButtonEventType::None;
+      return false;
+    }
+    ev = queue[tail];
+    queueTail = (tail + 1) & (QUEUE_SIZE - 1);
+    return true;
+  }
+
+}
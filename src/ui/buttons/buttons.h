@@ -12,16 +12,19 @@ Erkennung von Klick, Long-Press, Repeat
 Event-Interface für Menüsystem
 */
 
-enum class ButtonEventType { None, ShortPress, LongPress };
+#pragma once
+#include <stdint.h>
+
+enum class ButtonEventType { None, ShortPress, LongPress, Repeat };
 
 struct ButtonEvent {
-  uint8_t buttonId;
+  uint8_t buttonId;          // 1..BUTTON_COUNT
   ButtonEventType type;
+  unsigned long timeMs;      // millis() der auslösenden Flanke
 };
 
 namespace Buttons {
   void begin();
-  void update();
+  void update();             // Long-Press/Repeat + Abtastung der Pins ohne PCINT
   bool getNextEvent(ButtonEvent& ev);
 }
-
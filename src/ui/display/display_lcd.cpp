@@ -0,0 +1,215 @@
+/*
+Rolle:
+20×4 HD44780 über PCF8574 (hd44780_I2Cexp).
+
+Renderfunktionen schreiben nur in den RAM-Frame, flush() vergleicht
+mit dem Schatten und überträgt die Differenz in DDRAM-Reihenfolge
+(Zeile 0 → 2, Zeile 1 → 3), damit der Auto-Inkrement des Controllers
+möglichst viele setCursor()-Befehle einspart.
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <hd44780.h>
+#include <hd44780ioClass/hd44780_I2Cexp.h>
+#include "i2c_bus.h"
+#include "display_lcd.h"
+
+namespace {
+
+  constexpr uint8_t LCD_COLS = 20;
+  constexpr uint8_t LCD_ROWS = 4;
+  constexpr char    LCD_DEGREE = (char)0xDF;   // Gradzeichen im HD44780-ROM A00
+  constexpr uint8_t NO_ADDR = 0xFF;
+
+  hd44780_I2Cexp lcd;   // Auto-Scan für PCF8574/PCF8574A/AT Boards, siehe begin()
+
+  char shadow[LCD_ROWS][LCD_COLS];   // steht so auf dem Display
+  char frame[LCD_ROWS][LCD_COLS];    // soll als Nächstes drauf
+
+  // DDRAM-Startadressen eines 20×4: Zeile 2 schließt an Zeile 0 an, 3 an 1
+  const uint8_t ROW_ADDR[LCD_ROWS] = { 0x00, 0x40, 0x14, 0x54 };
+  const uint8_t FLUSH_ORDER[LCD_ROWS] = { 0, 2, 1, 3 };
+
+  uint8_t cursor_addr = NO_ADDR;     // aktueller Adresszähler des Controllers
+
+  void clearFrame() {
+    memset(frame, ' ', sizeof(frame));
+  }
+
+  void printAt(uint8_t col, uint8_t row, const char* text) {
+    for (; *text && col < LCD_COLS; ++text, ++col) {
+      frame[row][col] = *text;
+    }
+  }
+
+  void printValueAt(uint8_t col, uint8_t row, float value, int8_t width, uint8_t decimals) {
+    char buf[12];
+    dtostrf(value, width, decimals, buf);
+    printAt(col, row, buf);
+  }
+
+  void flush() {
+    I2CBus::lock();
+    for (uint8_t r = 0; r < LCD_ROWS; ++r) {
+      uint8_t row = FLUSH_ORDER[r];
+      for (uint8_t col = 0; col < LCD_COLS; ++col) {
+        char c = frame[row][col];
+        if (c == shadow[row][col]) continue;
+
+        uint8_t addr = ROW_ADDR[row] + col;
+        if (addr != cursor_addr) {
+          lcd.setCursor(col, row);
+        }
+        lcd.write((uint8_t)c);
+        shadow[row][col] = c;
+
+        // Controller zählt 0x27 -> 0x40 und 0x67 -> 0x00 weiter
+        cursor_addr = addr + 1;
+        if (cursor_addr == 0x28) cursor_addr = 0x40;
+        if (cursor_addr == 0x68) cursor_addr = 0x00;
+      }
+    }
+    I2CBus::unlock();
+  }
+
+}
+
+namespace DisplayLCD {
+
+    void begin() {
+        // bekannte Adresse aus der Geräte-Tabelle spart den Auto-Scan
+        uint8_t addr = I2CBus::address(I2CDevice::Lcd);
+        if (addr != I2C_NO_DEVICE) lcd = hd44780_I2Cexp(addr);
+        lcd.begin(LCD_COLS, LCD_ROWS);
+        lcd.clear();
+        memset(shadow, ' ', sizeof(shadow));
+        clearFrame();
+        cursor_addr = 0x00;   // clear() setzt den Cursor auf (0,0)
+    }
+
+    void clear() {
+        clearFrame();
+        flush();
+    }
+
+    void renderMain(const EnvData& env, const IMUData& imu, const BatteryStatus& bat) {
+        clearFrame();
+
+        // "T  21.3C   H  55.1%"
+        printAt(0, 0, "T");
+        printValueAt(2, 0, env.temperature, 5, 1);
+        printAt(7, 0, "C");
+        printAt(11, 0, "H");
+        printValueAt(13, 0, env.humidity, 5, 1);
+        printAt(18, 0, "%");
+
+        // "B 1013.2hPa  U 3.92V"
+        printAt(0, 1, "B");
+        printValueAt(2, 1, env.pressure, 6, 1);
+        printAt(8, 1, "hPa");
+        printAt(13, 1, "U");
+        printValueAt(15, 1, bat.voltage, 4, 2);
+        printAt(19, 1, "V");
+
+        // "R -12.3   P   4.5"
+        printAt(0, 2, "R");
+        printValueAt(2, 2, imu.roll, 5, 1);
+        frame[2][7] = LCD_DEGREE;
+        printAt(11, 2, "P");
+        printValueAt(13, 2, imu.pitch, 5, 1);
+        frame[2][18] = LCD_DEGREE;
+
+        // "Kurs 123    Akku 85%"
+        printAt(0, 3, "Kurs");
+        printValueAt(5, 3, imu.yaw, 3, 0);
+        frame[3][8] = LCD_DEGREE;
+        printAt(12, 3, "Akku");
+        printValueAt(16, 3, bat.percentage, 3, 0);
+        printAt(19, 3, "%");
+
+        flush();
+    }
+
+    void renderCompass(float headingDeg) {
+        clearFrame();
+
+        int16_t heading = (int16_t)lroundf(headingDeg) % 360;
+        if (heading < 0) heading += 360;
+
+        printAt(0, 0, "Kompass");
+        printValueAt(14, 0, heading, 3, 0);
+        frame[0][17] = LCD_DEGREE;
+
+        // Kursband: 10° pro Zeichen, Spalte 10 = aktueller Kurs
+        static const char cardinal[] = { 'N', 'O', 'S', 'W' };
+        for (uint8_t col = 0; col < LCD_COLS; ++col) {
+            int16_t b = ((heading + (col - 10) * 10) % 360 + 360) % 360;
+            int16_t tick = (b + 5) / 10 * 10 % 360;   // auf 10° runden
+            char c = '.';
+            if (tick % 90 == 0) c = cardinal[tick / 90];
+            else if (tick % 30 == 0) c = '|';
+            frame[2][col] = c;
+        }
+        frame[3][10] = '^';   // Steuerstrich
+
+        flush();
+    }
+
+    void renderAlarmSettings(uint8_t rule, AlarmField field, bool editing) {
+        static const char* const channelNames[] = {
+            "Temperatur", "Feuchte", "Luftdruck", "Kraengung", "Stampfen",
+            "Kurs", "Akku V", "Akku %", "Drucktend."
+        };
+        static const char* const patternNames[] = { "Info", "Warnung", "Kritisch" };
+
+        const AlarmRule& r = Alarms::getRule(rule);
+        clearFrame();
+
+        // "Alarm 1/4 Kraengung"
+        printAt(0, 0, "Alarm");
+        frame[0][6] = '1' + rule;
+        frame[0][7] = '/';
+        frame[0][8] = '0' + Alarms::getRuleCount();
+        printAt(10, 0, channelNames[static_cast<uint8_t>(r.channel)]);
+
+        // "[x] aktiv  Warnung"
+        printAt(1, 1, r.enabled ? "[x] aktiv" : "[ ] aus");
+        printAt(12, 1, patternNames[static_cast<uint8_t>(r.pattern) - static_cast<uint8_t>(BuzzerPattern::AlarmInfo)]);
+
+        // " S  30.0   H   3.0"
+        printAt(1, 2, "S");
+        printValueAt(3, 2, DataStore::rawToValue(r.channel, r.threshold), 6, 1);
+        printAt(11, 2, "H");
+        printValueAt(13, 2, DataStore::rawToValue(r.channel, r.hysteresis), 5, 1);
+
+        // " Halt   3s      EDIT"
+        printAt(1, 3, "Halt");
+        printValueAt(6, 3, r.holdOffS, 4, 0);
+        printAt(10, 3, "s");
+        if (editing) printAt(16, 3, "EDIT");
+
+        // Auswahlmarke vor dem Feld
+        if (editing) {
+            switch (field) {
+                case AlarmField::Enabled:    frame[1][0]  = '>'; break;
+                case AlarmField::Pattern:    frame[1][11] = '>'; break;
+                case AlarmField::Threshold:  frame[2][0]  = '>'; break;
+                case AlarmField::Hysteresis: frame[2][10] = '>'; break;
+                case AlarmField::HoldOff:    frame[3][0]  = '>'; break;
+                default: break;
+            }
+        }
+
+        flush();
+    }
+
+    void showSplash() {
+        clearFrame();
+        printAt(5, 0, "SailSense");
+        printAt(0, 1, "by Julian Kampitsch");
+        printAt(8, 2, "2025");
+        flush();
+    }
+
+}
@@ -0,0 +1,23 @@
+/*
+Rolle:
+20×4 HD44780 über PCF8574-I²C-Expander (hd44780_I2Cexp) steuern,
+mit derselben Schnittstelle wie DisplayOLED.
+
+Jedes Zeichen kostet über den Expander mehrere I²C-Bytes. Deshalb
+wird ein Schatten der 80 Zellen gehalten und nur geänderte Zeichen
+gesendet; Cursor-Sprünge entfallen, wo der Display-Adresszähler
+ohnehin auf die nächste Zelle zeigt.
+*/
+
+#pragma once
+#include "types.h"
+#include "alarms.h"
+
+namespace DisplayLCD {
+    void begin();
+    void clear();
+    void renderMain(const EnvData&, const IMUData&, const BatteryStatus&);
+    void renderCompass(float headingDeg);
+    void showSplash();
+    void renderAlarmSettings(uint8_t rule, AlarmField field, bool editing);
+}
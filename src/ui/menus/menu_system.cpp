@@ -10,5 +10,138 @@ Zustandsverwaltung der aktuellen Ansicht
 Reaktion auf Button-Events
 
 Aufruf von Display-Funktionen zum Rendern
+
+Tastenbelegung:
+  normal:          1 = nächster Screen, 2 = voriger Screen
+  Settings:        3 lang = Alarmregeln bearbeiten
+  IMU:             3 lang = Acc/Gyro neu kalibrieren (still und waagerecht)
+  Bearbeiten:      1 / 2 = Wert + / - (gehalten: in 10er-Schritten)
+                   3 = nächstes Feld, 4 = nächste Regel,
+                   3 lang = speichern und zurück
+  Alarm tönt:      erster kurzer Druck quittiert nur
 */
 
+#include <Arduino.h>
+#include "buttons.h"
+#include "buzzer.h"
+#include "input_recorder.h"
+#include "knockdown.h"
+#include "mpu9250_sensor.h"
+#include "menu_system.h"
+
+namespace {
+
+  constexpr uint8_t SCREEN_COUNT = static_cast<uint8_t>(ScreenId::SETTINGS) + 1;
+
+  ScreenId current = ScreenId::ENV;
+  bool editing = false;
+  uint8_t selectedRule = 0;
+  AlarmField selectedField = AlarmField::Enabled;
+  uint16_t uiSeq = 0;
+
+  void stepScreen(int8_t dir) {
+    uint8_t s = static_cast<uint8_t>(current);
+    s = (s + SCREEN_COUNT + dir) % SCREEN_COUNT;
+    current = static_cast<ScreenId>(s);
+  }
+
+  void handleEdit(const ButtonEvent& ev) {
+    bool shortPress = ev.type == ButtonEventType::ShortPress;
+    bool repeat = ev.type == ButtonEventType::Repeat;
+    int16_t step = repeat ? 10 : 1;
+
+    switch (ev.buttonId) {
+      case 1:
+        if (shortPress || repeat) Alarms::adjust(selectedRule, selectedField, step);
+        break;
+      case 2:
+        if (shortPress || repeat) Alarms::adjust(selectedRule, selectedField, -step);
+        break;
+      case 3:
+        if (shortPress) {
+          uint8_t f = (static_cast<uint8_t>(selectedField) + 1) % static_cast<uint8_t>(AlarmField::COUNT);
+          selectedField = static_cast<AlarmField>(f);
+        } else if (ev.type == ButtonEventType::LongPress) {
+          Alarms::save();
+          editing = false;
+          Buzzer::beepOk();
+        }
+        break;
+      case 4:
+        if (shortPress) {
+          selectedRule = (selectedRule + 1) % Alarms::getRuleCount();
+          selectedField = AlarmField::Enabled;
+        }
+        break;
+    }
+  }
+
+  void handle(const ButtonEvent& ev) {
+    if (ev.type == ButtonEventType::ShortPress && Knockdown::getState() != KnockdownState::Idle) {
+      Knockdown::acknowledge();
+      return;
+    }
+    if (ev.type == ButtonEventType::ShortPress && Alarms::anyActive() && Buzzer::isPlaying()) {
+      Alarms::acknowledge();
+      return;
+    }
+
+    if (editing) {
+      handleEdit(ev);
+      return;
+    }
+
+    if (ev.type == ButtonEventType::ShortPress) {
+      if (ev.buttonId == 1) stepScreen(1);
+      if (ev.buttonId == 2) stepScreen(-1);
+    } else if (ev.type == ButtonEventType::LongPress
+               && ev.buttonId == 3 && current == ScreenId::SETTINGS) {
+      editing = true;
+      selectedRule = 0;
+      selectedField = AlarmField::Enabled;
+    } else if (ev.type == ButtonEventType::LongPress
+               && ev.buttonId == 3 && current == ScreenId::IMU) {
+      MPU9250Module::requestCalibration();
+      Buzzer::beepOk();
+    }
+  }
+
+}
+
+namespace MenuSystem {
+
+  void begin() {
+    current = ScreenId::ENV;
+    editing = false;
+  }
+
+  void update() {
+    ButtonEvent ev;
+    while (Buttons::getNextEvent(ev)) {
+      InputRecorder::recordButton(ev.buttonId, static_cast<uint8_t>(ev.type));
+      handle(ev);
+      uiSeq++;
+    }
+  }
+
+  ScreenId getCurrentScreen() {
+    return current;
+  }
+
+  uint16_t getUiSeq() {
+    return uiSeq;
+  }
+
+  bool isEditing() {
+    return editing;
+  }
+
+  uint8_t getSelectedRule() {
+    return selectedRule;
+  }
+
+  AlarmField getSelectedField() {
+    return selectedField;
+  }
+
+}
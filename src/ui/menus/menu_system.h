@@ -13,6 +13,8 @@ Aufruf von Display-Funktionen zum Rendern
 */
 
 #pragma once
+#include <stdint.h>
+#include "alarms.h"
 
 enum class ScreenId {
 ENV, 
@@ -26,5 +28,10 @@ namespace MenuSystem {
   void begin();
   void update();               // verarbeitet Button-Events, wechselt Screens
   ScreenId getCurrentScreen();
-}
+  uint16_t getUiSeq();         // zählt bei jeder Eingabe (Editor, Quittieren) für den Redraw
 
+  // Settings: Alarmregeln bearbeiten
+  bool isEditing();
+  uint8_t getSelectedRule();
+  AlarmField getSelectedField();
+}
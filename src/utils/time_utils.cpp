@@ -0,0 +1,55 @@
+/*
+Rolle: Datumsrechnung auf Basis der Unix-Zeit.
+
+Inhalt:
+
+Das Jahr beginnt intern am 1. März, damit der Schalttag am Jahresende
+liegt. Eine Ära umfasst 400 Jahre = 146097 Tage. 719468 = Tage vom
+0000-03-01 bis 1970-01-01.
+*/
+
+#include "time_utils.h"
+
+namespace TimeUtils {
+
+  uint32_t daysFromCivil(uint16_t year, uint8_t month, uint8_t day) {
+    uint32_t y = year - (month <= 2 ? 1 : 0);
+    uint32_t era = y / 400;
+    uint32_t yoe = y - era * 400;                                   // 0..399
+    uint32_t mp  = month > 2 ? month - 3 : month + 9;               // März = 0
+    uint32_t doy = (153 * mp + 2) / 5 + day - 1;                    // 0..365
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;           // 0..146096
+    return era * 146097UL + doe - 719468UL;
+  }
+
+  void civilFromDays(uint32_t days, uint16_t& year, uint8_t& month, uint8_t& day) {
+    uint32_t z = days + 719468UL;
+    uint32_t era = z / 146097UL;
+    uint32_t doe = z - era * 146097UL;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp  = (5 * doy + 2) / 153;
+    day   = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    month = (uint8_t)(mp < 10 ? mp + 3 : mp - 9);
+    year  = (uint16_t)(yoe + era * 400 + (month <= 2 ? 1 : 0));
+  }
+
+  uint32_t toEpoch(uint16_t year, uint8_t month, uint8_t day,
+                   uint8_t hour, uint8_t minute, uint8_t second) {
+    return daysFromCivil(year, month, day) * SECONDS_PER_DAY
+         + hour * 3600UL + minute * 60U + second;
+  }
+
+  bool isLeapYear(uint16_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+  }
+
+  uint8_t weekday(uint32_t days) {
+    return (days + 4) % 7;                 // 1970-01-01 war ein Donnerstag
+  }
+
+  uint16_t dayOfYear(uint16_t year, uint8_t month, uint8_t day) {
+    return daysFromCivil(year, month, day) - daysFromCivil(year, 1, 1) + 1;
+  }
+
+}
@@ -0,0 +1,36 @@
+/*
+Rolle: Datumsrechnung auf Basis der Unix-Zeit (Sekunden seit 1970-01-01 UTC).
+
+Inhalt:
+
+Tage <-> Kalenderdatum ohne Schleifen und ohne Monatstabelle
+(Algorithmus von H. Hinnant, nur Ganzzahl-Arithmetik)
+
+Wochentag, Tag im Jahr, Index eines Zeit-Buckets (z. B. Stunde des Tages
+für die Verlaufsanzeige)
+
+Keine Arduino-Abhängigkeit, damit auch die PC-Tools die Funktionen nutzen
+können
+*/
+
+#pragma once
+#include <stdint.h>
+
+namespace TimeUtils {
+  constexpr uint32_t SECONDS_PER_DAY = 86400UL;
+
+  uint32_t daysFromCivil(uint16_t year, uint8_t month, uint8_t day);   // ab 1970-01-01
+  void     civilFromDays(uint32_t days, uint16_t& year, uint8_t& month, uint8_t& day);
+  uint32_t toEpoch(uint16_t year, uint8_t month, uint8_t day,
+                   uint8_t hour, uint8_t minute, uint8_t second);
+
+  bool     isLeapYear(uint16_t year);
+  uint8_t  weekday(uint32_t days);                                     // 0 = Sonntag
+  uint16_t dayOfYear(uint16_t year, uint8_t month, uint8_t day);       // 1..366
+
+  // Laufende Bucket-Nummer modulo count, z. B. bucketIndex(t, 3600, 24)
+  // = Stunde des Tages (UTC)
+  inline uint16_t bucketIndex(uint32_t epoch, uint32_t bucketSeconds, uint16_t count) {
+    return (epoch / bucketSeconds) % count;
+  }
+}
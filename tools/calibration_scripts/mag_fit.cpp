@@ -0,0 +1,401 @@
+/*
+Rolle: Hard-/Soft-Iron-Kalibrierung des Magnetometers aus SailSense-Logs
+(Ausgleichsrechnung über alle Messwerte, Gegenstück zu mag_calibrator.cpp).
+
+Inhalt:
+
+Liest Mag-Datensätze (unkorrigiert, Board-Achsen) und die zuletzt davor
+geloggte Lage (IMU-Datensatz) aus einer oder mehreren Logdateien.
+
+Fit: allgemeine Quadrik  p^T Q p + v^T p = 1  nach kleinsten Quadraten
+(Normalgleichungen, Daten vorher zentriert und skaliert).
+  3D (Ellipsoid, 9 Parameter), wenn Z genug überstrichen wurde (Gerät
+  gekippt), sonst 2D (Ellipse in X/Y, 5 Parameter) nur aus Werten bei
+  fast waagerechtem Gerät.
+Ergebnis: Mittelpunkt c und Form M mit (p - c)^T M (p - c) = 1.
+
+Ausgabe:
+  - volle Soft-Iron-Matrix W = R * sqrt(M) (Kugel bzw. Kreis mit Radius R)
+  - Näherung mit Skalierung je Achse, wie sie das Gerät anwendet
+    (halbe Spannweite der Ellipse je Achse, wie Min/Max auf dem Gerät)
+  - Kursfehler ohne Kalibrierung und mit der Näherung gegenüber dem
+    vollen Fit (waagerechte Werte)
+  - Zeilen für MAG_CAL_OFFSET / MAG_CAL_SCALE in src/core/config.h
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "log_reader.h"
+
+namespace {
+
+  constexpr double PI = 3.14159265358979323846;
+  constexpr size_t MIN_SAMPLES = 50;
+  constexpr double MIN_Z_SPAN = 0.5;     // Z-Spannweite relativ zu X/Y für einen 3D-Fit
+
+  struct Sample {
+    double p[3];
+    bool level;
+  };
+
+  struct Fit {
+    int    dims = 0;        // 2 oder 3, 0 = kein Fit
+    double c[3] = {};
+    double m[3][3] = {};
+    double radius = 0;      // Mittel der halben Spannweiten
+    double rmsPct = 0;      // Abstand der Werte von der Fläche, % von radius
+    size_t used = 0;
+  };
+
+  // Gauß mit Spaltenpivot, a wird überschrieben
+  bool solve(std::vector<std::vector<double>>& a, std::vector<double>& b, std::vector<double>& x) {
+    const size_t n = b.size();
+    for (size_t col = 0; col < n; ++col) {
+      size_t piv = col;
+      for (size_t r = col + 1; r < n; ++r) {
+        if (std::fabs(a[r][col]) > std::fabs(a[piv][col])) piv = r;
+      }
+      if (std::fabs(a[piv][col]) < 1e-12) return false;
+      std::swap(a[col], a[piv]);
+      std::swap(b[col], b[piv]);
+      for (size_t r = col + 1; r < n; ++r) {
+        double f = a[r][col] / a[col][col];
+        for (size_t k = col; k < n; ++k) a[r][k] -= f * a[col][k];
+        b[r] -= f * b[col];
+      }
+    }
+    x.assign(n, 0);
+    for (size_t i = n; i-- > 0;) {
+      double s = b[i];
+      for (size_t k = i + 1; k < n; ++k) s -= a[i][k] * x[k];
+      x[i] = s / a[i][i];
+    }
+    return true;
+  }
+
+  bool invert(const double in[3][3], double out[3][3], int n) {
+    for (int col = 0; col < n; ++col) {
+      std::vector<std::vector<double>> a(n, std::vector<double>(n));
+      std::vector<double> b(n, 0), x;
+      for (int r = 0; r < n; ++r) {
+        for (int k = 0; k < n; ++k) a[r][k] = in[r][k];
+      }
+      b[col] = 1;
+      if (!solve(a, b, x)) return false;
+      for (int r = 0; r < n; ++r) out[r][col] = x[r];
+    }
+    return true;
+  }
+
+  // Eigenzerlegung symmetrischer Matrizen (zyklischer Jacobi), v = Spalten
+  void jacobi(double a[3][3], double v[3][3], int n) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) v[i][j] = i == j ? 1 : 0;
+    }
+    for (int sweep = 0; sweep < 50; ++sweep) {
+      double off = 0;
+      for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) off += a[i][j] * a[i][j];
+      }
+      if (off < 1e-24) return;
+      for (int p = 0; p < n; ++p) {
+        for (int q = p + 1; q < n; ++q) {
+          if (std::fabs(a[p][q]) < 1e-30) continue;
+          double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+          double t = (theta >= 0 ? 1 : -1) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+          double c = 1 / std::sqrt(t * t + 1);
+          double s = t * c;
+          for (int k = 0; k < n; ++k) {
+            double akp = a[k][p], akq = a[k][q];
+            a[k][p] = c * akp - s * akq;
+            a[k][q] = s * akp + c * akq;
+          }
+          for (int k = 0; k < n; ++k) {
+            double apk = a[p][k], aqk = a[q][k];
+            a[p][k] = c * apk - s * aqk;
+            a[q][k] = s * apk + c * aqk;
+          }
+          for (int k = 0; k < n; ++k) {
+            double vkp = v[k][p], vkq = v[k][q];
+            v[k][p] = c * vkp - s * vkq;
+            v[k][q] = s * vkp + c * vkq;
+          }
+        }
+      }
+    }
+  }
+
+  // W = radius * sqrt(M)
+  void softIron(const Fit& f, double w[3][3]) {
+    double a[3][3], v[3][3];
+    std::memcpy(a, f.m, sizeof(a));
+    jacobi(a, v, f.dims);
+    std::memset(w, 0, sizeof(double) * 9);
+    for (int i = 0; i < f.dims; ++i) {
+      for (int j = 0; j < f.dims; ++j) {
+        double s = 0;
+        for (int k = 0; k < f.dims; ++k) s += v[i][k] * std::sqrt(std::max(a[k][k], 0.0)) * v[j][k];
+        w[i][j] = f.radius * s;
+      }
+    }
+  }
+
+  // Quadrik-Terme eines (zentrierten, skalierten) Punkts
+  int terms(const double* q, int dims, double* row) {
+    if (dims == 3) {
+      row[0] = q[0] * q[0]; row[1] = q[1] * q[1]; row[2] = q[2] * q[2];
+      row[3] = 2 * q[0] * q[1]; row[4] = 2 * q[0] * q[2]; row[5] = 2 * q[1] * q[2];
+      row[6] = q[0]; row[7] = q[1]; row[8] = q[2];
+      return 9;
+    }
+    row[0] = q[0] * q[0]; row[1] = q[1] * q[1]; row[2] = 2 * q[0] * q[1];
+    row[3] = q[0]; row[4] = q[1];
+    return 5;
+  }
+
+  Fit fitQuadric(const std::vector<Sample>& samples, int dims, bool levelOnly) {
+    Fit f;
+    double mean[3] = {}, scale = 0;
+    size_t n = 0;
+    for (const Sample& s : samples) {
+      if (levelOnly && !s.level) continue;
+      for (int i = 0; i < dims; ++i) mean[i] += s.p[i];
+      n++;
+    }
+    if (n < MIN_SAMPLES) return f;
+    for (int i = 0; i < dims; ++i) mean[i] /= n;
+    for (const Sample& s : samples) {
+      if (levelOnly && !s.level) continue;
+      for (int i = 0; i < dims; ++i) scale += (s.p[i] - mean[i]) * (s.p[i] - mean[i]);
+    }
+    scale = std::sqrt(scale / n);
+    if (scale <= 0) return f;
+
+    const int k = dims == 3 ? 9 : 5;
+    std::vector<std::vector<double>> ata(k, std::vector<double>(k, 0));
+    std::vector<double> atb(k, 0), x;
+    double row[9], q[3];
+    for (const Sample& s : samples) {
+      if (levelOnly && !s.level) continue;
+      for (int i = 0; i < dims; ++i) q[i] = (s.p[i] - mean[i]) / scale;
+      terms(q, dims, row);
+      for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < k; ++j) ata[i][j] += row[i] * row[j];
+        atb[i] += row[i];
+      }
+    }
+    if (!solve(ata, atb, x)) return f;
+
+    // Q (symmetrisch) und v in zentrierten Koordinaten
+    double Q[3][3] = {}, v[3] = {};
+    if (dims == 3) {
+      Q[0][0] = x[0]; Q[1][1] = x[1]; Q[2][2] = x[2];
+      Q[0][1] = Q[1][0] = x[3]; Q[0][2] = Q[2][0] = x[4]; Q[1][2] = Q[2][1] = x[5];
+      v[0] = x[6]; v[1] = x[7]; v[2] = x[8];
+    } else {
+      Q[0][0] = x[0]; Q[1][1] = x[1]; Q[0][1] = Q[1][0] = x[2];
+      v[0] = x[3]; v[1] = x[4];
+    }
+
+    // Mittelpunkt c' = -1/2 Q^-1 v, dann (q - c')^T Q (q - c') = 1 + c'^T Q c'
+    double Qi[3][3];
+    if (!invert(Q, Qi, dims)) return f;
+    double c[3] = {};
+    for (int i = 0; i < dims; ++i) {
+      for (int j = 0; j < dims; ++j) c[i] -= 0.5 * Qi[i][j] * v[j];
+    }
+    double kk = 1;
+    for (int i = 0; i < dims; ++i) {
+      for (int j = 0; j < dims; ++j) kk += c[i] * Q[i][j] * c[j];
+    }
+    if (kk <= 0) return f;
+
+    // zurück in µT
+    f.dims = dims;
+    for (int i = 0; i < dims; ++i) {
+      f.c[i] = mean[i] + scale * c[i];
+      for (int j = 0; j < dims; ++j) f.m[i][j] = Q[i][j] / kk / (scale * scale);
+    }
+
+    // positiv definit? Halbe Spannweiten aus der Inversen
+    double mi[3][3];
+    if (!invert(f.m, mi, dims)) { f.dims = 0; return f; }
+    for (int i = 0; i < dims; ++i) {
+      if (mi[i][i] <= 0) { f.dims = 0; return f; }
+      f.radius += std::sqrt(mi[i][i]) / dims;
+    }
+    double e[3][3], ev[3][3];
+    std::memcpy(e, f.m, sizeof(e));
+    jacobi(e, ev, dims);
+    for (int i = 0; i < dims; ++i) {
+      if (e[i][i] <= 0) { f.dims = 0; return f; }
+    }
+
+    double sq = 0;
+    for (const Sample& s : samples) {
+      if (levelOnly && !s.level) continue;
+      double d[3], r2 = 0;
+      for (int i = 0; i < dims; ++i) d[i] = s.p[i] - f.c[i];
+      for (int i = 0; i < dims; ++i) {
+        for (int j = 0; j < dims; ++j) r2 += d[i] * f.m[i][j] * d[j];
+      }
+      double err = std::sqrt(r2) - 1;
+      sq += err * err;
+      f.used++;
+    }
+    f.rmsPct = 100 * std::sqrt(sq / f.used);
+    return f;
+  }
+
+  // Skalierung je Achse wie auf dem Gerät: halbe Spannweite der Fläche
+  void diagonal(const Fit& f, float offset[3], float scale[3]) {
+    double mi[3][3];
+    invert(f.m, mi, f.dims);
+    for (int i = 0; i < 3; ++i) {
+      offset[i] = i < f.dims ? (float)f.c[i] : 0.0f;
+      scale[i]  = i < f.dims ? (float)(f.radius / std::sqrt(mi[i][i])) : 1.0f;
+    }
+  }
+
+  double wrapDeg(double d) {
+    while (d > 180) d -= 360;
+    while (d < -180) d += 360;
+    return d;
+  }
+
+  struct HeadingError {
+    double rms = 0, max = 0;
+  };
+
+  void addError(HeadingError& e, double d, size_t& n) {
+    e.rms += d * d;
+    e.max = std::max(e.max, std::fabs(d));
+    n++;
+  }
+
+  void usage(const char* prog) {
+    std::fprintf(stderr, "usage: %s [-t max-Neigung Grad] LOG*.BIN ...\n", prog);
+  }
+
+}
+
+int main(int argc, char** argv) {
+  double maxTilt = 5.0;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; ++i) {
+    std::string a = argv[i];
+    if (a == "-t" && i + 1 < argc) maxTilt = std::atof(argv[++i]);
+    else if (!a.empty() && a[0] != '-') files.push_back(a);
+    else { usage(argv[0]); return 2; }
+  }
+  if (files.empty()) { usage(argv[0]); return 2; }
+
+  std::vector<Sample> samples;
+  bool haveAttitude = false;
+  for (const std::string& path : files) {
+    MappedFile f(path);
+    if (!f.ok()) {
+      std::fprintf(stderr, "%s: nicht lesbar\n", path.c_str());
+      continue;
+    }
+    double roll = 0, pitch = 0;
+    bool attitude = false;
+    forEachBlock(f, [&](const LogBlock& b) {
+      for (uint8_t i = 0; i < b.header.count; ++i) {
+        const LogRecord& r = b.records[i];
+        if (r.type == static_cast<uint8_t>(LogType::IMU)) {
+          roll = r.v[0] / 100.0;
+          pitch = r.v[1] / 100.0;
+          attitude = true;
+          haveAttitude = true;
+        } else if (r.type == static_cast<uint8_t>(LogType::Mag)) {
+          Sample s;
+          for (int k = 0; k < 3; ++k) s.p[k] = r.v[k] / 10.0;
+          s.level = !attitude || (std::fabs(roll) <= maxTilt && std::fabs(pitch) <= maxTilt);
+          samples.push_back(s);
+        }
+      }
+    });
+  }
+
+  size_t level = 0;
+  double lo[3] = { 1e9, 1e9, 1e9 }, hi[3] = { -1e9, -1e9, -1e9 };
+  for (const Sample& s : samples) {
+    if (s.level) level++;
+    for (int i = 0; i < 3; ++i) {
+      lo[i] = std::min(lo[i], s.p[i]);
+      hi[i] = std::max(hi[i], s.p[i]);
+    }
+  }
+  std::printf("Mag-Werte: %zu, davon waagerecht (<= %.1f Grad): %zu%s\n", samples.size(), maxTilt, level,
+              haveAttitude ? "" : " (keine Lage im Log, alle gelten als waagerecht)");
+  if (samples.size() < MIN_SAMPLES) {
+    std::fprintf(stderr, "zu wenige Werte\n");
+    return 1;
+  }
+
+  Fit fit;
+  double spanXY = (hi[0] - lo[0] + hi[1] - lo[1]) / 2;
+  if (hi[2] - lo[2] >= MIN_Z_SPAN * spanXY) fit = fitQuadric(samples, 3, false);
+  if (fit.dims == 0) {
+    std::printf("Z kaum überstrichen (%.1f uT) -> Ellipse in X/Y aus waagerechten Werten\n", hi[2] - lo[2]);
+    fit = fitQuadric(samples, 2, true);
+  }
+  if (fit.dims == 0) {
+    std::fprintf(stderr, "kein Fit möglich (zu wenig Drehung? Vollkreis fahren)\n");
+    return 1;
+  }
+
+  std::printf("\n%dD-Fit über %zu Werte, Abweichung RMS %.2f %%\n", fit.dims, fit.used, fit.rmsPct);
+  std::printf("Mittelpunkt (Hard-Iron) uT: %8.2f %8.2f %8.2f\n", fit.c[0], fit.c[1], fit.c[2]);
+  std::printf("Radius uT: %.2f\n", fit.radius);
+
+  double w[3][3];
+  softIron(fit, w);
+  std::printf("Soft-Iron-Matrix W (korrigiert = W * (m - c)):\n");
+  for (int i = 0; i < fit.dims; ++i) {
+    std::printf("  ");
+    for (int j = 0; j < fit.dims; ++j) std::printf("%9.4f", w[i][j]);
+    std::printf("\n");
+  }
+
+  float offset[3], scale[3];
+  diagonal(fit, offset, scale);
+
+  // Kursfehler bei waagerechtem Gerät gegenüber dem vollen Fit
+  HeadingError raw, diag;
+  size_t nRaw = 0, nDiag = 0;
+  for (const Sample& s : samples) {
+    if (!s.level) continue;
+    double dx = s.p[0] - fit.c[0], dy = s.p[1] - fit.c[1];
+    double fx = w[0][0] * dx + w[0][1] * dy;
+    double fy = w[1][0] * dx + w[1][1] * dy;
+    if (fit.dims == 3) {
+      double dz = s.p[2] - fit.c[2];
+      fx += w[0][2] * dz;
+      fy += w[1][2] * dz;
+    }
+    double hFull = std::atan2(fy, fx) * 180 / PI;
+    double hDiag = std::atan2(dy * scale[1], dx * scale[0]) * 180 / PI;
+    double hRaw  = std::atan2(s.p[1], s.p[0]) * 180 / PI;
+    addError(raw, wrapDeg(hRaw - hFull), nRaw);
+    addError(diag, wrapDeg(hDiag - hFull), nDiag);
+  }
+  if (nRaw > 0) {
+    std::printf("\nKursfehler gegenüber vollem Fit (waagerecht)\n");
+    std::printf("  ohne Kalibrierung:       RMS %6.2f  max %6.2f Grad\n", std::sqrt(raw.rms / nRaw), raw.max);
+    std::printf("  Skalierung je Achse:     RMS %6.2f  max %6.2f Grad\n", std::sqrt(diag.rms / nDiag), diag.max);
+  }
+
+  std::printf("\nFür src/core/config.h:\n");
+  std::printf("constexpr float MAG_CAL_OFFSET[3] = { %.2ff, %.2ff, %.2ff };\n", offset[0], offset[1], offset[2]);
+  std::printf("constexpr float MAG_CAL_SCALE[3]  = { %.4ff, %.4ff, %.4ff };\n", scale[0], scale[1], scale[2]);
+  if (fit.dims == 2) std::printf("(Z nicht bestimmt: Offset 0, Skalierung 1)\n");
+  return 0;
+}
@@ -0,0 +1,297 @@
+/*
+Rolle: SailSense-Binärlogs (LOGnnnnn.BIN) nach CSV oder Spaltendateien.
+
+Inhalt:
+
+Jede Eingabedatei wird per mmap() eingeblendet und in einem Durchgang
+dekodiert; Datensätze werden direkt in der Abbildung gelesen
+
+CSV: eine Datei pro Datensatztyp (<log>_imu.csv, <log>_env.csv ...),
+Zahlen werden aus den Festkomma-Ganzzahlen ohne printf formatiert
+
+Spalten (-f col): Verzeichnis <log>.col/ mit einer Binärdatei pro Spalte
+(<typ>.utc_ms.i64 als int64, sonst float64, little endian), direkt mit
+numpy.fromfile() lesbar
+
+-d N behält jeden N-ten Datensatz pro Typ, -t wählt Typen aus
+
+Mehrere Dateien werden parallel verarbeitet (-j Threads)
+*/
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "log_reader.h"
+
+namespace {
+
+  enum class Format { Csv, Columns };
+
+  struct Options {
+    Format format = Format::Csv;
+    uint32_t decimate = 1;
+    bool typeEnabled[LOG_TYPE_COUNT];
+    unsigned threads = 0;
+    std::string outDir;
+    std::vector<std::string> inputs;
+  };
+
+  std::mutex printLock;
+
+  // Gepufferte Ausgabe; fwrite() erst ab BUF_SIZE
+  class Writer {
+  public:
+    static const size_t BUF_SIZE = 1 << 20;
+
+    explicit Writer(const std::string& path) : buf(BUF_SIZE) {
+      f = std::fopen(path.c_str(), "wb");
+    }
+    ~Writer() {
+      flush();
+      if (f) std::fclose(f);
+    }
+    bool ok() const { return f != nullptr; }
+
+    char* reserve(size_t n) {
+      if (used + n > buf.size()) flush();
+      return buf.data() + used;
+    }
+    void commit(char* end) { used = end - buf.data(); }
+    void write(const void* p, size_t n) {
+      char* dst = reserve(n);
+      std::memcpy(dst, p, n);
+      commit(dst + n);
+    }
+    void flush() {
+      if (f && used) std::fwrite(buf.data(), 1, used, f);
+      used = 0;
+    }
+
+  private:
+    FILE* f = nullptr;
+    std::vector<char> buf;
+    size_t used = 0;
+  };
+
+  char* appendInt(char* p, uint64_t v) {
+    char tmp[20];
+    int n = 0;
+    do { tmp[n++] = char('0' + v % 10); v /= 10; } while (v);
+    while (n) *p++ = tmp[--n];
+    return p;
+  }
+
+  // Festkomma -> Text, z. B. (-1234, 2) -> "-12.34"
+  char* appendFixed(char* p, int64_t v, uint8_t decimals) {
+    static const uint64_t POW10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
+    uint64_t u = v < 0 ? uint64_t(-v) : uint64_t(v);
+    if (v < 0) *p++ = '-';
+    if (decimals == 0) return appendInt(p, u);
+    uint64_t scale = POW10[decimals];
+    p = appendInt(p, u / scale);
+    *p++ = '.';
+    uint64_t frac = u % scale;
+    for (int d = decimals - 1; d >= 0; --d) {
+      *p++ = char('0' + frac / POW10[d] % 10);
+    }
+    return p;
+  }
+
+  std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+  }
+
+  // Ausgabeziele für einen Typ
+  struct TypeSink {
+    std::unique_ptr<Writer> csv;
+    std::vector<std::unique_ptr<Writer>> cols;   // [0] = utc_ms
+    uint64_t seen = 0;
+    uint64_t written = 0;
+  };
+
+  bool openSinks(const Options& opt, const std::string& input, TypeSink sinks[]) {
+    std::string dir = opt.outDir.empty() ? std::string(".") : opt.outDir;
+    std::string base = dir + "/" + baseName(input);
+    if (opt.format == Format::Columns) {
+      base += ".col";
+      if (::mkdir(base.c_str(), 0755) != 0 && errno != EEXIST) return false;
+    }
+
+    for (size_t t = 0; t < LOG_TYPE_COUNT; ++t) {
+      if (!opt.typeEnabled[t]) continue;
+      const TypeInfo& ti = LOG_TYPES[t];
+      if (opt.format == Format::Csv) {
+        sinks[t].csv.reset(new Writer(base + "_" + ti.name + ".csv"));
+        if (!sinks[t].csv->ok()) return false;
+        std::string header = "utc_ms";
+        for (uint8_t c = 0; c < ti.columnCount; ++c) header += std::string(",") + ti.columns[c].name;
+        header += "\n";
+        sinks[t].csv->write(header.data(), header.size());
+      } else {
+        std::string prefix = base + "/" + ti.name + ".";
+        sinks[t].cols.emplace_back(new Writer(prefix + "utc_ms.i64"));
+        for (uint8_t c = 0; c < ti.columnCount; ++c) {
+          sinks[t].cols.emplace_back(new Writer(prefix + ti.columns[c].name + ".f64"));
+        }
+        for (auto& w : sinks[t].cols) {
+          if (!w->ok()) return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void exportRecord(const Options& opt, const TypeInfo& ti, TypeSink& sink,
+                    const LogBlockHeader& h, const LogRecord& r) {
+    static const double SCALE[] = { 1.0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7 };
+    int64_t utc = recordUtcMs(h, r);
+
+    if (opt.format == Format::Csv) {
+      char* p = sink.csv->reserve(160);
+      if (utc < 0) { *p++ = '-'; p = appendInt(p, uint64_t(-utc)); }
+      else p = appendInt(p, uint64_t(utc));
+      for (uint8_t c = 0; c < ti.columnCount; ++c) {
+        *p++ = ',';
+        p = appendFixed(p, columnRaw(r, ti.columns[c]), ti.columns[c].decimals);
+      }
+      *p++ = '\n';
+      sink.csv->commit(p);
+    } else {
+      sink.cols[0]->write(&utc, sizeof(utc));
+      for (uint8_t c = 0; c < ti.columnCount; ++c) {
+        double v = columnRaw(r, ti.columns[c]) * SCALE[ti.columns[c].decimals];
+        sink.cols[c + 1]->write(&v, sizeof(v));
+      }
+    }
+    sink.written++;
+  }
+
+  bool exportFile(const Options& opt, const std::string& input) {
+    MappedFile f(input);
+    if (!f.ok()) {
+      std::lock_guard<std::mutex> g(printLock);
+      std::fprintf(stderr, "%s: kann nicht gelesen werden\n", input.c_str());
+      return false;
+    }
+
+    TypeSink sinks[LOG_TYPE_COUNT];
+    if (!openSinks(opt, input, sinks)) {
+      std::lock_guard<std::mutex> g(printLock);
+      std::fprintf(stderr, "%s: Ausgabe kann nicht angelegt werden\n", input.c_str());
+      return false;
+    }
+
+    BlockStats st = forEachBlock(f, [&](const LogBlock& b) {
+      for (uint8_t i = 0; i < b.header.count; ++i) {
+        const LogRecord& r = b.records[i];
+        int t = typeIndex(r.type);
+        if (t < 0 || !opt.typeEnabled[t]) continue;
+        TypeSink& sink = sinks[t];
+        if (sink.seen++ % opt.decimate != 0) continue;
+        exportRecord(opt, LOG_TYPES[t], sink, b.header, r);
+      }
+    });
+
+    uint64_t written = 0;
+    for (size_t t = 0; t < LOG_TYPE_COUNT; ++t) written += sinks[t].written;
+
+    std::lock_guard<std::mutex> g(printLock);
+    std::printf("%s: %llu Blöcke, %llu Datensätze, %llu ausgegeben, %llu CRC-Fehler, %llu Lücken, %llu verworfen, %llu alt\n",
+                input.c_str(),
+                (unsigned long long)st.blocks, (unsigned long long)st.records,
+                (unsigned long long)written, (unsigned long long)st.crcErrors,
+                (unsigned long long)st.seqGaps, (unsigned long long)st.dropped,
+                (unsigned long long)st.staleBlocks);
+    return true;
+  }
+
+  void usage(const char* prog) {
+    std::fprintf(stderr,
+      "usage: %s [-f csv|col] [-d N] [-t typ,typ] [-j threads] [-o dir] LOG*.BIN\n"
+      "  Typen: imu mag env battery gpspos gpsvel event (Standard: alle)\n", prog);
+  }
+
+  bool parseTypes(const char* arg, Options& opt) {
+    for (size_t t = 0; t < LOG_TYPE_COUNT; ++t) opt.typeEnabled[t] = false;
+    std::string s(arg);
+    size_t pos = 0;
+    while (pos <= s.size()) {
+      size_t end = s.find(',', pos);
+      if (end == std::string::npos) end = s.size();
+      std::string name = s.substr(pos, end - pos);
+      bool found = false;
+      for (size_t t = 0; t < LOG_TYPE_COUNT; ++t) {
+        if (name == LOG_TYPES[t].name) { opt.typeEnabled[t] = true; found = true; }
+      }
+      if (!found) return false;
+      pos = end + 1;
+    }
+    return true;
+  }
+
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (size_t t = 0; t < LOG_TYPE_COUNT; ++t) opt.typeEnabled[t] = true;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string a = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (a == "-f" && hasValue) {
+      std::string v = argv[++i];
+      if (v == "csv") opt.format = Format::Csv;
+      else if (v == "col") opt.format = Format::Columns;
+      else { usage(argv[0]); return 2; }
+    } else if (a == "-d" && hasValue) {
+      opt.decimate = std::strtoul(argv[++i], nullptr, 10);
+      if (opt.decimate == 0) { usage(argv[0]); return 2; }
+    } else if (a == "-t" && hasValue) {
+      if (!parseTypes(argv[++i], opt)) { usage(argv[0]); return 2; }
+    } else if (a == "-j" && hasValue) {
+      opt.threads = std::strtoul(argv[++i], nullptr, 10);
+    } else if (a == "-o" && hasValue) {
+      opt.outDir = argv[++i];
+    } else if (!a.empty() && a[0] != '-') {
+      opt.inputs.push_back(a);
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (opt.inputs.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  unsigned threads = opt.threads ? opt.threads : std::thread::hardware_concurrency();
+  if (threads == 0) threads = 1;
+  if (threads > opt.inputs.size()) threads = static_cast<unsigned>(opt.inputs.size());
+
+  std::atomic<size_t> next(0);
+  std::atomic<unsigned> failures(0);
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([&]() {
+      for (size_t i = next++; i < opt.inputs.size(); i = next++) {
+        if (!exportFile(opt, opt.inputs[i])) failures++;
+      }
+    });
+  }
+  for (auto& th : pool) th.join();
+
+  return failures ? 1 : 0;
+}
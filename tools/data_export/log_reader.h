@@ -0,0 +1,160 @@
+/*
+Rolle: Gemeinsamer Lesezugriff auf SailSense-Logdateien (PC-Tools).
+
+Inhalt:
+
+MappedFile: Datei per mmap() einblenden (nur lesen, sequentiell)
+
+forEachBlock(): läuft einmal über alle 512-Byte-Blöcke, prüft Magic,
+Version, Dateikennung, Sequenznummer und CRC, liefert Zeiger direkt in
+die Abbildung (keine Kopie)
+
+Spaltenbeschreibung pro Datensatztyp: Name, Quelle im Datensatz,
+Nachkommastellen. Die Werte bleiben Festkomma-Ganzzahlen wie auf dem Gerät.
+
+Format siehe src/logging/log_format.h
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "log_format.h"
+
+class MappedFile {
+public:
+  explicit MappedFile(const std::string& path) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) return;
+    len = static_cast<size_t>(st.st_size);
+    void* p = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) { len = 0; return; }
+    ::madvise(p, len, MADV_SEQUENTIAL);
+    base = static_cast<const uint8_t*>(p);
+  }
+  ~MappedFile() {
+    if (base) ::munmap(const_cast<uint8_t*>(base), len);
+    if (fd >= 0) ::close(fd);
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool ok() const { return base != nullptr; }
+  const uint8_t* data() const { return base; }
+  size_t size() const { return len; }
+
+private:
+  int fd = -1;
+  const uint8_t* base = nullptr;
+  size_t len = 0;
+};
+
+struct BlockStats {
+  uint64_t blocks = 0;
+  uint64_t records = 0;
+  uint64_t crcErrors = 0;     // Block übersprungen
+  uint64_t seqGaps = 0;
+  uint64_t dropped = 0;       // vom Gerät gemeldete verworfene Datensätze
+  uint64_t staleBlocks = 0;   // Rest nach dem Ende, nicht ausgewertet
+};
+
+// Ende = erster Block ohne Magic (Rest der Datei nie beschrieben), mit
+// anderer Dateikennung als der erste Block oder mit rückwärts springender
+// seq: nach einem Stromausfall bleibt die Datei vorreserviert, dahinter
+// liegen evtl. Blöcke einer gelöschten älteren Datei
+template <typename BlockFn>
+BlockStats forEachBlock(const MappedFile& f, BlockFn fn) {
+  BlockStats st;
+  const size_t n = f.size() / LOG_BLOCK_SIZE;
+  uint32_t expectSeq = 0;
+  const LogBlockHeader* first = nullptr;
+  for (size_t i = 0; i < n; ++i) {
+    const LogBlock* b = reinterpret_cast<const LogBlock*>(f.data() + i * LOG_BLOCK_SIZE);
+    const LogBlockHeader& h = b->header;
+    if (h.magic != LOG_MAGIC || h.version != LOG_VERSION) break;
+    if (!first) first = &h;
+    if (h.fileNumber != first->fileNumber || h.fileEpoch != first->fileEpoch
+        || h.seq < expectSeq) {
+      st.staleBlocks = n - i;
+      break;
+    }
+    if (h.count > LOG_RECORDS_PER_BLOCK
+        || logCrc(b->records, h.count * sizeof(LogRecord)) != h.crc) {
+      st.crcErrors++;
+      expectSeq = h.seq + 1;
+      continue;
+    }
+    if (h.seq != expectSeq) st.seqGaps++;
+    expectSeq = h.seq + 1;
+
+    st.blocks++;
+    st.records += h.count;
+    st.dropped += h.dropped;
+    fn(*b);
+  }
+  return st;
+}
+
+// UTC in ms aus Blockkopf und millis()-Zeitstempel des Datensatzes
+inline int64_t recordUtcMs(const LogBlockHeader& h, const LogRecord& r) {
+  return static_cast<int64_t>(h.startEpoch) * 1000 + static_cast<int32_t>(r.timeMs - h.startMs);
+}
+
+enum class Src : uint8_t { S16, U16, Lat, Lon };
+
+struct Column {
+  const char* name;
+  Src     src;
+  uint8_t slot;
+  uint8_t decimals;
+  int32_t bias;           // wird vor der Ausgabe addiert (Rohwert-Einheit)
+};
+
+struct TypeInfo {
+  LogType     type;
+  const char* name;
+  uint8_t     columnCount;
+  Column      columns[5];
+};
+
+static const TypeInfo LOG_TYPES[] = {
+  { LogType::IMU,     "imu",     3, { {"roll_deg", Src::S16, 0, 2, 0}, {"pitch_deg", Src::S16, 1, 2, 0},
+                                      {"heading_deg", Src::S16, 2, 1, 0} } },
+  { LogType::Mag,     "mag",     3, { {"x_uT", Src::S16, 0, 1, 0}, {"y_uT", Src::S16, 1, 1, 0},
+                                      {"z_uT", Src::S16, 2, 1, 0} } },
+  { LogType::Env,     "env",     3, { {"temp_C", Src::S16, 0, 2, 0}, {"humidity_pct", Src::S16, 1, 2, 0},
+                                      {"pressure_hPa", Src::S16, 2, 2, 100000} } },
+  { LogType::Battery, "battery", 2, { {"voltage_V", Src::S16, 0, 3, 0}, {"percent", Src::S16, 1, 0, 0} } },
+  { LogType::GPSPos,  "gpspos",  2, { {"lat_deg", Src::Lat, 0, 7, 0}, {"lon_deg", Src::Lon, 0, 7, 0} } },
+  { LogType::GPSVel,  "gpsvel",  4, { {"sog_kn", Src::U16, 0, 2, 0}, {"cog_deg", Src::U16, 1, 2, 0},
+                                      {"hdop", Src::U16, 2, 2, 0}, {"satellites", Src::S16, 3, 0, 0} } },
+  { LogType::Event,   "event",   2, { {"code", Src::S16, 0, 0, 0}, {"arg", Src::S16, 1, 0, 0} } },
+};
+static const size_t LOG_TYPE_COUNT = sizeof(LOG_TYPES) / sizeof(LOG_TYPES[0]);
+
+// Index in LOG_TYPES oder -1
+inline int typeIndex(uint8_t type) {
+  for (size_t i = 0; i < LOG_TYPE_COUNT; ++i) {
+    if (static_cast<uint8_t>(LOG_TYPES[i].type) == type) return static_cast<int>(i);
+  }
+  return -1;
+}
+
+inline int64_t columnRaw(const LogRecord& r, const Column& c) {
+  switch (c.src) {
+    case Src::S16: return r.v[c.slot] + c.bias;
+    case Src::U16: return static_cast<uint16_t>(r.v[c.slot]) + c.bias;
+    case Src::Lat: return r.pos.latE7;
+    case Src::Lon: return r.pos.lonE7;
+  }
+  return 0;
+}
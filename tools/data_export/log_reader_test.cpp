@@ -0,0 +1,126 @@
+/*
+Rolle: Prüft forEachBlock() aus log_reader.h an künstlichen Logdateien.
+
+Inhalt:
+
+Jeder Fall baut eine Datei aus Blöcken wie sd_logger.cpp sie schreibt
+(Kopf, CRC über die Datensätze), legt sie in einem Temp-Verzeichnis ab
+und vergleicht die BlockStats mit dem erwarteten Ergebnis
+
+Fälle: normale Datei, Datei nach dem Dateiwechsel (LOG00002 mit
+Resten einer älteren Datei dahinter), Block mit falscher CRC,
+Lücke in der seq, rückwärts springende seq derselben Datei
+
+Rückgabewert 0 = alle Fälle bestanden
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "log_reader.h"
+
+namespace {
+
+  int failures = 0;
+
+  LogBlock makeBlock(uint16_t fileNumber, uint32_t fileEpoch, uint32_t seq, uint8_t count) {
+    LogBlock b;
+    std::memset(&b, 0, sizeof(b));
+    b.header.magic = LOG_MAGIC;
+    b.header.version = LOG_VERSION;
+    b.header.seq = seq;
+    b.header.fileNumber = fileNumber;
+    b.header.fileEpoch = fileEpoch;
+    b.header.startEpoch = fileEpoch + seq;
+    b.header.count = count;
+    for (uint8_t i = 0; i < count; ++i) {
+      b.records[i].timeMs = seq * 1000 + i;
+      b.records[i].type = static_cast<uint8_t>(LogType::IMU);
+      b.records[i].v[0] = static_cast<int16_t>(seq);
+    }
+    b.header.crc = logCrc(b.records, count * sizeof(LogRecord));
+    return b;
+  }
+
+  std::string writeFile(const char* dir, const char* name, const std::vector<LogBlock>& blocks) {
+    std::string path = std::string(dir) + "/" + name;
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return path;
+    std::fwrite(blocks.data(), sizeof(LogBlock), blocks.size(), f);
+    std::fclose(f);
+    return path;
+  }
+
+  struct Expect {
+    uint64_t blocks, records, crcErrors, seqGaps, staleBlocks;
+  };
+
+  void check(const char* dir, const char* name, const std::vector<LogBlock>& blocks, const Expect& e) {
+    std::string path = writeFile(dir, name, blocks);
+    MappedFile f(path);
+    uint64_t seen = 0;
+    BlockStats st;
+    if (f.ok()) st = forEachBlock(f, [&](const LogBlock&) { seen++; });
+    bool ok = f.ok() && seen == e.blocks && st.blocks == e.blocks && st.records == e.records
+              && st.crcErrors == e.crcErrors && st.seqGaps == e.seqGaps
+              && st.staleBlocks == e.staleBlocks;
+    std::printf("%-5s %s: %llu Blöcke, %llu Datensätze, %llu CRC, %llu Lücken, %llu alt\n",
+                ok ? "ok" : "FEHL", name,
+                (unsigned long long)st.blocks, (unsigned long long)st.records,
+                (unsigned long long)st.crcErrors, (unsigned long long)st.seqGaps,
+                (unsigned long long)st.staleBlocks);
+    if (!ok) failures++;
+    std::remove(path.c_str());
+  }
+
+}
+
+int main() {
+  char dir[] = "/tmp/log_reader_testXXXXXX";
+  if (!mkdtemp(dir)) {
+    std::perror("mkdtemp");
+    return 2;
+  }
+
+  // eine Datei, ganz geschrieben
+  {
+    std::vector<LogBlock> v;
+    for (uint32_t s = 0; s < 4; ++s) v.push_back(makeBlock(1, 1000, s, LOG_RECORDS_PER_BLOCK));
+    check(dir, "normal", v, { 4, 4 * LOG_RECORDS_PER_BLOCK, 0, 0, 0 });
+  }
+
+  // Dateiwechsel: LOG00002 beginnt mit seq 0 und eigener Kennung, auch der
+  // Block, der beim Wechsel schon voll war. Dahinter liegt noch ein Rest der
+  // gelöschten LOG00001 am selben Platz der Karte.
+  {
+    std::vector<LogBlock> v;
+    for (uint32_t s = 0; s < 3; ++s) v.push_back(makeBlock(2, 5000, s, LOG_RECORDS_PER_BLOCK));
+    v.push_back(makeBlock(2, 5000, 3, 7));
+    for (uint32_t s = 4; s < 6; ++s) v.push_back(makeBlock(1, 1000, s, LOG_RECORDS_PER_BLOCK));
+    check(dir, "rollover", v, { 4, 3 * LOG_RECORDS_PER_BLOCK + 7, 0, 0, 2 });
+  }
+
+  // falsche CRC: Block übersprungen, seq läuft weiter
+  {
+    std::vector<LogBlock> v;
+    for (uint32_t s = 0; s < 3; ++s) v.push_back(makeBlock(3, 7000, s, LOG_RECORDS_PER_BLOCK));
+    v[1].records[0].v[1] ^= 1;
+    check(dir, "crc", v, { 2, 2 * LOG_RECORDS_PER_BLOCK, 1, 0, 0 });
+  }
+
+  // Lücke (Block nie geschrieben) und danach rückwärts springende seq
+  {
+    std::vector<LogBlock> v;
+    v.push_back(makeBlock(4, 9000, 0, 1));
+    v.push_back(makeBlock(4, 9000, 2, 1));
+    v.push_back(makeBlock(4, 9000, 1, 1));
+    check(dir, "seq", v, { 2, 2, 0, 1, 1 });
+  }
+
+  rmdir(dir);
+  std::printf("%s\n", failures == 0 ? "alle Fälle bestanden" : "FEHLER");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,414 @@
+/*
+Rolle: Auswertung vieler SailSense-Logs mehrerer Boote auf einmal.
+
+Inhalt:
+
+Durchsucht ein Verzeichnis rekursiv nach LOG*.BIN; der Name des
+Verzeichnisses, in dem eine Datei liegt, gilt als Bootsname
+
+Thread-Pool mit Work-Stealing: jeder Thread hat eine eigene Warteschlange
+(große Dateien zuerst), ist sie leer, nimmt er Arbeit vom Ende einer
+fremden Schlange
+
+Pro Datei läuft ein Durchgang über die Datensätze (mmap, log_reader.h).
+Der Zustand pro Törn ist fest begrenzt:
+  - maximale Krängung
+  - Rollperiode: Nulldurchgänge um einen gleitenden Mittelwert, Histogramm
+  - Luftdrucktendenz: 15-min-Ring über 3 h wie auf dem Gerät, Ereignis bei
+    schneller Änderung
+  - Akkukurve: feste Anzahl Stützpunkte, bei Überlauf wird das Raster
+    verdoppelt (je zwei Punkte zusammengefasst)
+
+Ein neuer Törn beginnt mit jeder Datei und nach mehr als TRIP_GAP_MS ohne
+Datensatz. Ausgabe: trips.csv, roll_periods.csv, pressure_events.csv,
+battery_curves.csv
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "log_reader.h"
+
+namespace {
+
+  constexpr int64_t TRIP_GAP_MS = 30LL * 60 * 1000;
+
+  // Rollperiode
+  constexpr double ROLL_MEAN_TAU_S     = 30.0;   // gleitender Mittelwert (Trimm, Dauerkrängung)
+  constexpr double ROLL_HYSTERESIS_DEG = 0.5;
+  constexpr double PERIOD_BIN_S        = 0.5;
+  constexpr int    PERIOD_BINS         = 40;     // 0 .. 20 s
+
+  // Luftdruck
+  constexpr int     TREND_SLOTS       = 13;      // 0 .. 3 h in 15 min
+  constexpr int64_t TREND_INTERVAL_MS = 15LL * 60 * 1000;
+  constexpr double  TREND_EVENT_HPA   = 4.0;     // |Änderung in 3 h|, ab der ein Ereignis zählt
+  constexpr size_t  MAX_EVENTS        = 64;
+
+  // Akkukurve
+  constexpr size_t  BATTERY_POINTS    = 64;
+  constexpr int64_t BATTERY_START_MS  = 60LL * 1000;
+
+  struct PressureEvent {
+    int64_t utcMs;
+    double  hpaPer3h;
+  };
+
+  struct BatteryPoint {
+    int64_t utcMs;
+    double  minV;
+  };
+
+  struct Trip {
+    std::string boat, file;
+    int64_t startMs = 0, endMs = 0;
+    uint64_t records = 0;
+
+    double  maxHeel = 0;
+    int64_t maxHeelMs = 0;
+
+    uint32_t periodHist[PERIOD_BINS] = {};
+    uint32_t periodCount = 0;
+
+    std::vector<PressureEvent> events;
+    uint32_t eventsTotal = 0;
+
+    std::vector<BatteryPoint> battery;
+    int64_t batteryBucketMs = BATTERY_START_MS;
+    double  batteryFirstV = NAN, batteryLastV = NAN;
+  };
+
+  // Laufender Zustand eines Törns (Filter, Ringpuffer), nicht Teil des Ergebnisses
+  struct TripState {
+    bool     haveRoll = false;
+    double   rollMean = 0;
+    int64_t  lastRollMs = 0;
+    int8_t   side = 0;               // -1/+1 gegenüber Mittelwert, mit Hysterese
+    int64_t  lastUpCrossMs = -1;
+
+    double   trend[TREND_SLOTS];
+    int      trendIndex = 0, trendCount = 0;
+    int64_t  trendLastMs = 0;
+    bool     inEvent = false;
+  };
+
+  void onRoll(Trip& trip, TripState& s, int64_t t, double roll) {
+    if (std::fabs(roll) > trip.maxHeel) {
+      trip.maxHeel = std::fabs(roll);
+      trip.maxHeelMs = t;
+    }
+
+    if (!s.haveRoll) {
+      s.haveRoll = true;
+      s.rollMean = roll;
+      s.lastRollMs = t;
+      return;
+    }
+    double dt = (t - s.lastRollMs) / 1000.0;
+    s.lastRollMs = t;
+    if (dt <= 0) return;
+    s.rollMean += (roll - s.rollMean) * std::min(1.0, dt / ROLL_MEAN_TAU_S);
+
+    double d = roll - s.rollMean;
+    if (d > ROLL_HYSTERESIS_DEG && s.side <= 0) {
+      if (s.side < 0 && s.lastUpCrossMs >= 0) {
+        double period = (t - s.lastUpCrossMs) / 1000.0;
+        int bin = static_cast<int>(period / PERIOD_BIN_S);
+        if (period > 0 && bin < PERIOD_BINS) {
+          trip.periodHist[bin]++;
+          trip.periodCount++;
+        }
+      }
+      s.lastUpCrossMs = t;
+      s.side = 1;
+    } else if (d < -ROLL_HYSTERESIS_DEG && s.side >= 0) {
+      s.side = -1;
+    }
+  }
+
+  void onPressure(Trip& trip, TripState& s, int64_t t, double hpa) {
+    if (s.trendCount > 0 && t - s.trendLastMs < TREND_INTERVAL_MS) return;
+    s.trend[s.trendIndex] = hpa;
+    s.trendIndex = (s.trendIndex + 1) % TREND_SLOTS;
+    if (s.trendCount < TREND_SLOTS) s.trendCount++;
+    s.trendLastMs = t;
+    if (s.trendCount < 4) return;
+
+    int newest = (s.trendIndex + TREND_SLOTS - 1) % TREND_SLOTS;
+    int oldest = (s.trendIndex + TREND_SLOTS - s.trendCount) % TREND_SLOTS;
+    double per3h = (s.trend[newest] - s.trend[oldest]) * (TREND_SLOTS - 1) / (s.trendCount - 1);
+
+    bool over = std::fabs(per3h) >= TREND_EVENT_HPA;
+    if (over && !s.inEvent) {
+      trip.eventsTotal++;
+      if (trip.events.size() < MAX_EVENTS) trip.events.push_back({ t, per3h });
+    }
+    s.inEvent = over;
+  }
+
+  void onBattery(Trip& trip, int64_t t, double volts) {
+    if (std::isnan(trip.batteryFirstV)) trip.batteryFirstV = volts;
+    trip.batteryLastV = volts;
+
+    int64_t slot = (t - trip.startMs) / trip.batteryBucketMs * trip.batteryBucketMs + trip.startMs;
+    if (!trip.battery.empty() && trip.battery.back().utcMs == slot) {
+      trip.battery.back().minV = std::min(trip.battery.back().minV, volts);
+      return;
+    }
+    if (trip.battery.size() == BATTERY_POINTS) {
+      // Raster verdoppeln: je zwei Punkte zusammenfassen
+      trip.batteryBucketMs *= 2;
+      std::vector<BatteryPoint> merged;
+      for (const BatteryPoint& p : trip.battery) {
+        int64_t s2 = (p.utcMs - trip.startMs) / trip.batteryBucketMs * trip.batteryBucketMs + trip.startMs;
+        if (!merged.empty() && merged.back().utcMs == s2) {
+          merged.back().minV = std::min(merged.back().minV, p.minV);
+        } else {
+          merged.push_back({ s2, p.minV });
+        }
+      }
+      trip.battery.swap(merged);
+      onBattery(trip, t, volts);
+      return;
+    }
+    trip.battery.push_back({ slot, volts });
+  }
+
+  void analyseFile(const std::string& boat, const std::string& path, std::vector<Trip>& out) {
+    MappedFile f(path);
+    if (!f.ok()) {
+      std::fprintf(stderr, "%s: kann nicht gelesen werden\n", path.c_str());
+      return;
+    }
+
+    Trip trip;
+    TripState state;
+    bool open = false;
+
+    auto finish = [&]() {
+      if (open && trip.records > 0) out.push_back(std::move(trip));
+      trip = Trip();
+      state = TripState();
+      open = false;
+    };
+
+    forEachBlock(f, [&](const LogBlock& b) {
+      for (uint8_t i = 0; i < b.header.count; ++i) {
+        const LogRecord& r = b.records[i];
+        int64_t t = recordUtcMs(b.header, r);
+
+        if (open && t - trip.endMs > TRIP_GAP_MS) finish();
+        if (!open) {
+          open = true;
+          trip.boat = boat;
+          trip.file = path;
+          trip.startMs = t;
+        }
+        trip.endMs = std::max(trip.endMs, t);
+        trip.records++;
+
+        switch (static_cast<LogType>(r.type)) {
+          case LogType::IMU:     onRoll(trip, state, t, r.v[0] / 100.0); break;
+          case LogType::Env:     onPressure(trip, state, t, r.v[2] / 100.0 + 1000.0); break;
+          case LogType::Battery: onBattery(trip, t, r.v[0] / 1000.0); break;
+          default: break;
+        }
+      }
+    });
+    finish();
+  }
+
+  struct Job {
+    std::string boat, path;
+    off_t size;
+  };
+
+  // Work-Stealing: eigene Schlange vorne abarbeiten, fremde hinten bestehlen
+  class StealingPool {
+  public:
+    explicit StealingPool(unsigned n) : queues(n), locks(n) {}
+
+    void push(unsigned worker, const Job& j) {
+      queues[worker % queues.size()].push_back(j);
+    }
+
+    bool take(unsigned self, Job& j) {
+      {
+        std::lock_guard<std::mutex> g(locks[self]);
+        if (!queues[self].empty()) {
+          j = queues[self].front();
+          queues[self].pop_front();
+          return true;
+        }
+      }
+      for (unsigned k = 1; k < queues.size(); ++k) {
+        unsigned victim = (self + k) % queues.size();
+        std::lock_guard<std::mutex> g(locks[victim]);
+        if (!queues[victim].empty()) {
+          j = queues[victim].back();
+          queues[victim].pop_back();
+          return true;
+        }
+      }
+      return false;
+    }
+
+  private:
+    std::vector<std::deque<Job>> queues;
+    std::vector<std::mutex> locks;
+  };
+
+  bool isLogFile(const char* name) {
+    size_t n = std::strlen(name);
+    return n > 4 && std::strncmp(name, "LOG", 3) == 0 && std::strcmp(name + n - 4, ".BIN") == 0;
+  }
+
+  void scan(const std::string& dir, const std::string& boat, std::vector<Job>& jobs) {
+    DIR* d = ::opendir(dir.c_str());
+    if (!d) return;
+    while (dirent* e = ::readdir(d)) {
+      if (e->d_name[0] == '.') continue;
+      std::string path = dir + "/" + e->d_name;
+      struct stat st;
+      if (::stat(path.c_str(), &st) != 0) continue;
+      if (S_ISDIR(st.st_mode)) {
+        scan(path, e->d_name, jobs);
+      } else if (S_ISREG(st.st_mode) && isLogFile(e->d_name)) {
+        jobs.push_back({ boat, path, st.st_size });
+      }
+    }
+    ::closedir(d);
+  }
+
+  std::string iso(int64_t utcMs) {
+    time_t t = static_cast<time_t>(utcMs / 1000);
+    struct tm tm;
+    gmtime_r(&t, &tm);
+    char buf[32];
+    std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    return buf;
+  }
+
+  // Perzentil aus dem Histogramm (Bin-Mitte)
+  double periodPercentile(const Trip& t, double p) {
+    if (t.periodCount == 0) return NAN;
+    uint32_t target = static_cast<uint32_t>(std::ceil(p * t.periodCount));
+    uint32_t acc = 0;
+    for (int i = 0; i < PERIOD_BINS; ++i) {
+      acc += t.periodHist[i];
+      if (acc >= target && acc > 0) return (i + 0.5) * PERIOD_BIN_S;
+    }
+    return NAN;
+  }
+
+  void writeResults(const std::string& outDir, std::vector<Trip>& trips) {
+    std::sort(trips.begin(), trips.end(), [](const Trip& a, const Trip& b) {
+      return a.boat != b.boat ? a.boat < b.boat : a.startMs < b.startMs;
+    });
+
+    std::string base = outDir.empty() ? "." : outDir;
+    FILE* ft = std::fopen((base + "/trips.csv").c_str(), "w");
+    FILE* fp = std::fopen((base + "/roll_periods.csv").c_str(), "w");
+    FILE* fe = std::fopen((base + "/pressure_events.csv").c_str(), "w");
+    FILE* fb = std::fopen((base + "/battery_curves.csv").c_str(), "w");
+    if (!ft || !fp || !fe || !fb) {
+      std::fprintf(stderr, "Ausgabe in %s nicht möglich\n", base.c_str());
+      std::exit(1);
+    }
+
+    std::fprintf(ft, "boat,trip,file,start,end,hours,records,max_heel_deg,max_heel_at,"
+                     "roll_periods,roll_period_p10_s,roll_period_p50_s,roll_period_p90_s,"
+                     "pressure_events,battery_start_V,battery_end_V,battery_min_V\n");
+    std::fprintf(fp, "boat,trip,bin_start_s,count\n");
+    std::fprintf(fe, "boat,trip,time,hPa_per_3h\n");
+    std::fprintf(fb, "boat,trip,time,min_V\n");
+
+    for (size_t i = 0; i < trips.size(); ++i) {
+      const Trip& t = trips[i];
+      double minV = NAN;
+      for (const BatteryPoint& p : t.battery) minV = std::isnan(minV) ? p.minV : std::min(minV, p.minV);
+
+      std::fprintf(ft, "%s,%zu,%s,%s,%s,%.2f,%llu,%.2f,%s,%u,%.1f,%.1f,%.1f,%u,%.3f,%.3f,%.3f\n",
+                   t.boat.c_str(), i, t.file.c_str(), iso(t.startMs).c_str(), iso(t.endMs).c_str(),
+                   (t.endMs - t.startMs) / 3600000.0, (unsigned long long)t.records,
+                   t.maxHeel, iso(t.maxHeelMs).c_str(), t.periodCount,
+                   periodPercentile(t, 0.1), periodPercentile(t, 0.5), periodPercentile(t, 0.9),
+                   t.eventsTotal, t.batteryFirstV, t.batteryLastV, minV);
+      for (int b = 0; b < PERIOD_BINS; ++b) {
+        if (t.periodHist[b]) std::fprintf(fp, "%s,%zu,%.1f,%u\n", t.boat.c_str(), i, b * PERIOD_BIN_S, t.periodHist[b]);
+      }
+      for (const PressureEvent& e : t.events) {
+        std::fprintf(fe, "%s,%zu,%s,%.1f\n", t.boat.c_str(), i, iso(e.utcMs).c_str(), e.hpaPer3h);
+      }
+      for (const BatteryPoint& p : t.battery) {
+        std::fprintf(fb, "%s,%zu,%s,%.3f\n", t.boat.c_str(), i, iso(p.utcMs).c_str(), p.minV);
+      }
+    }
+    std::fclose(ft);
+    std::fclose(fp);
+    std::fclose(fe);
+    std::fclose(fb);
+  }
+
+  void usage(const char* prog) {
+    std::fprintf(stderr, "usage: %s [-j threads] [-o dir] logverzeichnis\n", prog);
+  }
+
+}
+
+int main(int argc, char** argv) {
+  unsigned threads = 0;
+  std::string outDir, root;
+  for (int i = 1; i < argc; ++i) {
+    std::string a = argv[i];
+    if (a == "-j" && i + 1 < argc) threads = std::strtoul(argv[++i], nullptr, 10);
+    else if (a == "-o" && i + 1 < argc) outDir = argv[++i];
+    else if (!a.empty() && a[0] != '-' && root.empty()) root = a;
+    else { usage(argv[0]); return 2; }
+  }
+  if (root.empty()) { usage(argv[0]); return 2; }
+
+  std::vector<Job> jobs;
+  scan(root, ".", jobs);
+  if (jobs.empty()) {
+    std::fprintf(stderr, "keine LOG*.BIN unter %s\n", root.c_str());
+    return 1;
+  }
+  // große Dateien zuerst, reihum verteilt; Stehlen gleicht den Rest aus
+  std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.size > b.size; });
+
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min<unsigned>(threads, jobs.size());
+  StealingPool pool(threads);
+  for (size_t i = 0; i < jobs.size(); ++i) pool.push(i % threads, jobs[i]);
+
+  std::vector<std::vector<Trip>> results(threads);
+  std::vector<std::thread> workers;
+  for (unsigned w = 0; w < threads; ++w) {
+    workers.emplace_back([&, w]() {
+      Job j;
+      while (pool.take(w, j)) analyseFile(j.boat, j.path, results[w]);
+    });
+  }
+  for (auto& th : workers) th.join();
+
+  std::vector<Trip> trips;
+  for (auto& r : results) {
+    for (auto& t : r) trips.push_back(std::move(t));
+  }
+  writeResults(outDir, trips);
+  std::printf("%zu Dateien, %zu Törns\n", jobs.size(), trips.size());
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*
+Rolle: NMEA-Logs auf dem PC durch den Parser aus src/navigation schicken.
+
+Inhalt:
+
+Liest ein aufgezeichnetes NMEA-Log (eine Datei, beliebige Zeilenenden)
+komplett in den Speicher und füttert es Zeichen für Zeichen in NmeaParser
+
+Zählt Sätze pro Typ und Prüfsummenfehler, gibt den letzten Fix aus
+
+Mit -n N wird das Log N-mal abgespielt und der Durchsatz in Sätzen
+pro Sekunde gemessen
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "nmea_parser.h"
+
+namespace {
+
+  void usage(const char* prog) {
+    std::fprintf(stderr, "usage: %s [-n repeats] [-q] log.nmea\n", prog);
+  }
+
+  void printFix(const GPSData& g) {
+    std::printf("UTC      %04u-%02u-%02u %02u:%02u:%02u.%02u%s\n",
+                g.year, g.month, g.day, g.hour, g.minute, g.second, g.centisecond,
+                g.timeValid ? "" : " (ungueltig)");
+    std::printf("Position %.7f %.7f %s\n", g.latE7 / 1e7, g.lonE7 / 1e7,
+                g.fixValid ? "(Fix)" : "(kein Fix)");
+    std::printf("SOG/COG  %.2f kn / %.2f deg\n", g.sogCKn / 100.0, g.cogCDeg / 100.0);
+    std::printf("GGA      Qualitaet %u, %u Sat, HDOP %.2f, Hoehe %.2f m\n",
+                g.fixQuality, g.satellites, g.hdopC / 100.0, g.altitudeCm / 100.0);
+  }
+
+}
+
+int main(int argc, char** argv) {
+  long repeats = 1;
+  bool quiet = false;
+  const char* path = nullptr;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      repeats = std::strtol(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "-q") == 0) {
+      quiet = true;
+    } else if (argv[i][0] != '-' && !path) {
+      path = argv[i];
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (!path || repeats < 1) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::fprintf(stderr, "kann %s nicht oeffnen\n", path);
+    return 1;
+  }
+  std::vector<char> log((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  NmeaParser parser;
+  unsigned long counts[6] = {};
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (long r = 0; r < repeats; ++r) {
+    for (char c : log) {
+      counts[static_cast<uint8_t>(parser.feed(c))]++;
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  double secs = std::chrono::duration<double>(t1 - t0).count();
+
+  unsigned long sentences = parser.sentenceCount() + parser.checksumErrors();
+  std::printf("Saetze   %lu (RMC %lu, GGA %lu, VTG %lu, andere %lu)\n", sentences,
+              counts[static_cast<uint8_t>(NmeaSentence::RMC)],
+              counts[static_cast<uint8_t>(NmeaSentence::GGA)],
+              counts[static_cast<uint8_t>(NmeaSentence::VTG)],
+              counts[static_cast<uint8_t>(NmeaSentence::Other)]);
+  std::printf("Fehler   %lu Pruefsummenfehler\n", (unsigned long)parser.checksumErrors());
+  if (!quiet) printFix(parser.data());
+
+  double bytes = static_cast<double>(log.size()) * repeats;
+  std::printf("Zeit     %.3f s, %.0f Saetze/s, %.1f MB/s\n", secs,
+              secs > 0 ? sentences / secs : 0.0, secs > 0 ? bytes / secs / 1e6 : 0.0);
+  return parser.checksumErrors() ? 3 : 0;
+}
@@ -0,0 +1,126 @@
+/*
+Rolle: Zustand der "Platine" beim Abspielen auf dem PC.
+
+Inhalt:
+
+Buzzer: gleiche Priorität wie src/alerts/buzzer.cpp (eine laufende höhere
+Folge wird nicht unterbrochen). Ok/Error sind kurze Quittungstöne und
+gelten sofort als beendet, Alarmmuster laufen bis alarmOff()/stop().
+
+Buttons: Warteschlange, gefüllt aus Button-Einträgen des Stroms
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <Wire.h>
+
+#include "buttons.h"
+#include "buzzer.h"
+#include "host_board.h"
+
+EEPROMClass EEPROM;
+TwoWire Wire;
+
+namespace {
+
+  uint32_t nowMs = 0;
+  float imuValues[6] = { 0, 0, 1, 0, 0, 0 };
+  float gyroValues[3] = { 0, 0, 0 };
+  float envValues[3] = { 0, 0, 0 };
+
+  constexpr uint8_t QUEUE_SIZE = 8;
+  ButtonEvent queue[QUEUE_SIZE];
+  uint8_t queueHead = 0;
+  uint8_t queueTail = 0;
+
+  bool buzzerActive = false;
+  uint8_t buzzerCurrent = 0;
+  uint32_t starts = 0;
+
+  void start(BuzzerPattern pattern) {
+    uint8_t id = static_cast<uint8_t>(pattern);
+    if (id >= static_cast<uint8_t>(BuzzerPattern::COUNT)) return;
+    if (buzzerActive && id < buzzerCurrent) return;
+    starts++;
+    buzzerCurrent = id;
+    buzzerActive = id >= static_cast<uint8_t>(BuzzerPattern::AlarmInfo);
+  }
+
+}
+
+namespace HostBoard {
+
+  void reset() {
+    memset(EEPROM.mem, 0xFF, sizeof(EEPROM.mem));
+    nowMs = 0;
+    const float imu0[6] = { 0, 0, 1, 0, 0, 0 };
+    memcpy(imuValues, imu0, sizeof(imuValues));
+    memset(gyroValues, 0, sizeof(gyroValues));
+    memset(envValues, 0, sizeof(envValues));
+    queueHead = queueTail = 0;
+    buzzerActive = false;
+    buzzerCurrent = 0;
+    starts = 0;
+  }
+
+  void setMillis(uint32_t ms) { nowMs = ms; }
+  uint32_t millis() { return nowMs; }
+
+  void setImu(const float v[6]) { memcpy(imuValues, v, sizeof(imuValues)); }
+  const float* imu() { return imuValues; }
+  void setGyro(const float v[3]) { memcpy(gyroValues, v, sizeof(gyroValues)); }
+  const float* gyro() { return gyroValues; }
+  void setEnv(const float v[3]) { memcpy(envValues, v, sizeof(envValues)); }
+  const float* env() { return envValues; }
+
+  void pushButton(uint8_t buttonId, uint8_t type) {
+    uint8_t next = (queueHead + 1) % QUEUE_SIZE;
+    if (next == queueTail) return;
+    queue[queueHead].buttonId = buttonId;
+    queue[queueHead].type = static_cast<ButtonEventType>(type);
+    queue[queueHead].timeMs = nowMs;
+    queueHead = next;
+  }
+
+  uint8_t buzzerPattern() { return buzzerActive ? buzzerCurrent : 0xFF; }
+  uint32_t buzzerStarts() { return starts; }
+
+}
+
+namespace Buttons {
+
+  void begin() { queueHead = queueTail = 0; }
+  void update() {}
+
+  bool getNextEvent(ButtonEvent& ev) {
+    if (queueTail == queueHead) return false;
+    ev = queue[queueTail];
+    queueTail = (queueTail + 1) % QUEUE_SIZE;
+    return true;
+  }
+
+}
+
+namespace Buzzer {
+
+  void begin() { buzzerActive = false; }
+  void beepOk() { start(BuzzerPattern::Ok); }
+  void beepError() { start(BuzzerPattern::Error); }
+  void alarmOn(BuzzerPattern pattern) { start(pattern); }
+
+  void alarmOff() {
+    if (buzzerActive && buzzerCurrent >= static_cast<uint8_t>(BuzzerPattern::AlarmInfo)) {
+      buzzerActive = false;
+    }
+  }
+
+  void alarmOff(BuzzerPattern pattern) {
+    if (buzzerActive && buzzerCurrent == static_cast<uint8_t>(pattern)) buzzerActive = false;
+  }
+
+  void play(BuzzerPattern pattern) { start(pattern); }
+  void stop() { buzzerActive = false; }
+  bool isPlaying() { return buzzerActive; }
+  void update() {}
+
+}
@@ -0,0 +1,34 @@
+/*
+Rolle: Zustand der "Platine" beim Abspielen auf dem PC.
+
+Inhalt:
+
+Uhr (millis() = Zeit des aktuellen Eintrags), letzte IMU- und BME-Werte
+für die Ersatzklassen in shim/
+
+Ersatz für Buzzer und Buttons: Taster-Events kommen aus dem Strom, der
+Buzzer merkt sich nur, welches Alarmmuster gerade läuft
+*/
+
+#pragma once
+#include <stdint.h>
+
+namespace HostBoard {
+  void reset();                     // EEPROM gelöscht, Uhr 0, keine Events
+
+  void setMillis(uint32_t ms);
+  uint32_t millis();
+
+  void setImu(const float v[6]);    // Beschleunigung g, Magnetfeld µT (Chip-Achsen)
+  const float* imu();
+  void setGyro(const float v[3]);   // °/s (Chip-Achsen), nur sea_sim
+  const float* gyro();
+  void setEnv(const float v[3]);    // °C, %, Pa
+  const float* env();
+
+  void pushButton(uint8_t buttonId, uint8_t type);
+
+  // 0xFF = still, sonst BuzzerPattern
+  uint8_t buzzerPattern();
+  uint32_t buzzerStarts();
+}
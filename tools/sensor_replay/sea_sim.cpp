@@ -0,0 +1,302 @@
+/*
+Rolle: Firmware-Module mit synthetischem Seegang betreiben (PC-Simulation).
+
+Inhalt:
+
+SeaState erzeugt pro Abtastschritt Beschleunigung, Drehrate und
+Magnetfeld; über den MPU9250_WE-Ersatz (shim/) laufen sie durch
+  Knockdown::checkSample()       (wie der Data-Ready-ISR, Rohwerte ±8 g)
+  MPU9250Module::update()        (Lage und Kurs)
+  DataStore::publishIMU()        (Quantisierung + Totband)
+  Knockdown::update(), Alarms::update()
+
+Ausgewertet wird gegen die wahre Lage: mittlere Abweichung, Streuung,
+größter Fehler und Verzögerung (Verschiebung mit dem kleinsten
+quadratischen Fehler) für Roll/Pitch/Kurs, jeweils direkt aus dem Modul
+und aus dem DataStore; dazu die ersten Auslösungen der Alarmregeln und
+des Knockdown-Pfads.
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <unistd.h>
+
+#include "alarms.h"
+#include "bme280_sensor.h"
+#include "buttons.h"
+#include "data_store.h"
+#include "host_board.h"
+#include "knockdown.h"
+#include "mpu9250_sensor.h"
+#include "sea_state.h"
+
+namespace {
+
+  void usage(const char* prog) {
+    std::fprintf(stderr,
+      "usage: %s [-r Hz] [-d s] [-H Kurs] [-e Kraengung] [-T Periode] [-a Roll-Amp]\n"
+      "          [-p Pitch-Amp] [-y Gier-Amp] [-z Tauchen m] [-l Hebelarm m]\n"
+      "          [-A acc-Rauschen g] [-G gyro-Rauschen dps] [-M mag-Rauschen uT]\n"
+      "          [-i hx,hy,hz] [-x] [-k Knockdown-Start s] [-s seed] [-c out.csv] [-q]\n", prog);
+  }
+
+  double wrap180(double d) {
+    while (d >= 180.0) d -= 360.0;
+    while (d < -180.0) d += 360.0;
+    return d;
+  }
+
+  struct Series {
+    const char* name;
+    bool angle360;               // Kurs: Differenzen modulo 360
+    std::vector<double> truth, meas;
+  };
+
+  struct ErrorStats {
+    double bias = 0, rms = 0, maxAbs = 0;
+    long   lagSamples = 0;
+  };
+
+  double diff(const Series& s, size_t i, size_t j) {
+    double d = s.meas[j] - s.truth[i];
+    return s.angle360 ? wrap180(d) : d;
+  }
+
+  // Fehler ohne Bias; beim Kurs wieder auf ±180 gefaltet
+  double centred(const Series& s, double e, double bias) {
+    return s.angle360 ? wrap180(e - bias) : e - bias;
+  }
+
+  ErrorStats analyse(const Series& s, size_t skip, long maxLag) {
+    ErrorStats st;
+    size_t n = s.truth.size();
+    if (n <= skip + static_cast<size_t>(maxLag) + 1) return st;
+
+    if (s.angle360) {
+      // Kreismittel: ein Fehler um ±180 mittelt sich sonst zu 0
+      double sn = 0, cs = 0;
+      for (size_t i = skip; i < n; ++i) {
+        double rad = diff(s, i, i) * M_PI / 180.0;
+        sn += std::sin(rad);
+        cs += std::cos(rad);
+      }
+      st.bias = std::atan2(sn, cs) * 180.0 / M_PI;
+    } else {
+      double sum = 0;
+      for (size_t i = skip; i < n; ++i) sum += diff(s, i, i);
+      st.bias = sum / (n - skip);
+    }
+
+    // Verschiebung, bei der Messung(t + L) - Bias am besten zur Wahrheit(t) passt
+    double best = -1;
+    for (long lag = 0; lag <= maxLag; ++lag) {
+      double sq = 0;
+      for (size_t i = skip; i + lag < n; ++i) {
+        double e = centred(s, diff(s, i, i + lag), st.bias);
+        sq += e * e;
+      }
+      sq /= (n - skip - lag);
+      if (best < 0 || sq < best - 1e-9) {    // bei Gleichstand die kleinste Verschiebung
+        best = sq;
+        st.lagSamples = lag;
+      }
+    }
+
+    double sq = 0;
+    for (size_t i = skip; i < n; ++i) {
+      double e = diff(s, i, i);
+      double c = centred(s, e, st.bias);
+      sq += c * c;
+      if (std::fabs(e) > st.maxAbs) st.maxAbs = std::fabs(e);
+    }
+    st.rms = std::sqrt(sq / (n - skip));
+    return st;
+  }
+
+  bool parseTriple(const char* s, double v[3]) {
+    return std::sscanf(s, "%lf,%lf,%lf", &v[0], &v[1], &v[2]) == 3;
+  }
+
+  int16_t toRaw8g(float g) {
+    float lsb = g * 4096.0f;   // ±8 g -> 4096 LSB/g
+    if (lsb > 32767.0f) return 32767;
+    if (lsb < -32768.0f) return -32768;
+    return static_cast<int16_t>(std::lround(lsb));
+  }
+
+}
+
+int main(int argc, char** argv) {
+  SeaStateParams prm;
+  double rateHz = 100.0;
+  double durationS = 600.0;
+  const char* csvPath = nullptr;
+  bool quiet = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "r:d:H:e:T:a:p:y:z:l:A:G:M:i:xk:s:c:q")) != -1) {
+    switch (opt) {
+      case 'r': rateHz = std::atof(optarg); break;
+      case 'd': durationS = std::atof(optarg); break;
+      case 'H': prm.headingDeg = std::atof(optarg); break;
+      case 'e': prm.heelDeg = std::atof(optarg); break;
+      case 'T': prm.periodS = std::atof(optarg); break;
+      case 'a': prm.rollAmpDeg = std::atof(optarg); break;
+      case 'p': prm.pitchAmpDeg = std::atof(optarg); break;
+      case 'y': prm.yawAmpDeg = std::atof(optarg); break;
+      case 'z': prm.heaveAmpM = std::atof(optarg); break;
+      case 'l': prm.leverM = std::atof(optarg); break;
+      case 'A': prm.accNoiseG = std::atof(optarg); break;
+      case 'G': prm.gyroNoiseDps = std::atof(optarg); break;
+      case 'M': prm.magNoiseUT = std::atof(optarg); break;
+      case 'i':
+        if (!parseTriple(optarg, prm.hardIronUT)) { usage(argv[0]); return 2; }
+        break;
+      case 'x': prm.magChipAxes = true; break;
+      case 'k': prm.knockStartS = std::atof(optarg); break;
+      case 's': prm.seed = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 10)); break;
+      case 'c': csvPath = optarg; break;
+      case 'q': quiet = true; break;
+      default: usage(argv[0]); return 2;
+    }
+  }
+  if (optind != argc || rateHz <= 0 || durationS <= 0 || prm.periodS <= 0) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  FILE* csv = nullptr;
+  if (csvPath) {
+    csv = std::fopen(csvPath, "w");
+    if (!csv) {
+      std::fprintf(stderr, "%s: kann nicht geschrieben werden\n", csvPath);
+      return 2;
+    }
+    std::fprintf(csv, "t_s,true_roll,true_pitch,true_yaw,imu_roll,imu_pitch,imu_yaw,"
+                      "store_roll,store_pitch,store_yaw,acc_x,acc_y,acc_z,"
+                      "gyr_x,gyr_y,gyr_z,mag_x,mag_y,mag_z,alarms,knockdown\n");
+  }
+
+  // Wie systemInit(), ohne Anzeige/GPS/RTC/Logger
+  HostBoard::reset();
+  Buttons::begin();
+  Buzzer::begin();
+  MPU9250Module::begin();
+  BME280Sensor::begin();
+  DataStore::begin();
+  Alarms::begin();
+
+  // Umwelt und Akku unauffällig, damit nur Lage-Alarme auslösen
+  const float env[3] = { 15.0f, 70.0f, 101325.0f };
+  HostBoard::setEnv(env);
+  BME280Sensor::update();
+  DataStore::publishEnv(BME280Sensor::getEnvData());
+  BatteryStatus bat = { 4.0f, 90.0f };
+  DataStore::publishBattery(bat);
+
+  SeaState sea(prm);
+  const size_t steps = static_cast<size_t>(durationS * rateHz);
+
+  Series series[6] = {
+    { "imu   roll ", false, {}, {} }, { "imu   pitch", false, {}, {} }, { "imu   kurs ", true, {}, {} },
+    { "store roll ", false, {}, {} }, { "store pitch", false, {}, {} }, { "store kurs ", true, {}, {} }
+  };
+  for (Series& s : series) {
+    s.truth.reserve(steps);
+    s.meas.reserve(steps);
+  }
+
+  const uint8_t ruleCount = Alarms::getRuleCount();
+  std::vector<double> ruleFirst(ruleCount, -1.0);
+  double truthOver30 = -1, truthOver60 = -1, knockLatched = -1, knockConfirmed = -1;
+  std::chrono::duration<double> firmwareTime(0);
+
+  for (size_t i = 0; i < steps; ++i) {
+    double t = i / rateHz;
+    SeaSample s = sea.at(t);
+    HostBoard::setMillis(static_cast<uint32_t>(std::lround(t * 1000.0)));
+
+    const float imu[6] = { s.acc[0], s.acc[1], s.acc[2], s.mag[0], s.mag[1], s.mag[2] };
+    HostBoard::setImu(imu);
+    HostBoard::setGyro(s.gyro);
+
+    auto t0 = std::chrono::steady_clock::now();
+    Knockdown::checkSample(toRaw8g(s.acc[0]), toRaw8g(s.acc[2]));
+    MPU9250Module::update();
+    DataStore::publishIMU(MPU9250Module::getIMU());
+    Knockdown::update();
+    Alarms::update();
+    firmwareTime += std::chrono::steady_clock::now() - t0;
+
+    IMUData m = MPU9250Module::getIMU();
+    IMUData q = DataStore::getIMU();
+    const double truth[3] = { s.rollDeg, s.pitchDeg, s.yawDeg };
+    const double meas[6] = { m.roll, m.pitch, m.yaw, q.roll, q.pitch, q.yaw };
+    for (int k = 0; k < 6; ++k) {
+      series[k].truth.push_back(truth[k % 3]);
+      series[k].meas.push_back(meas[k]);
+    }
+
+    if (truthOver30 < 0 && std::fabs(s.rollDeg) > 30.0) truthOver30 = t;
+    if (truthOver60 < 0 && std::fabs(s.rollDeg) > 60.0) truthOver60 = t;
+    uint8_t mask = 0;
+    for (uint8_t r = 0; r < ruleCount; ++r) {
+      if (!Alarms::isActive(r)) continue;
+      mask |= static_cast<uint8_t>(1 << r);
+      if (ruleFirst[r] < 0) ruleFirst[r] = t;
+    }
+    KnockdownState ks = Knockdown::getState();
+    if (knockLatched < 0 && ks != KnockdownState::Idle) knockLatched = t;
+    if (knockConfirmed < 0 && ks == KnockdownState::Confirmed) knockConfirmed = t;
+
+    if (csv) {
+      std::fprintf(csv, "%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f,%.0f,"
+                        "%.4f,%.4f,%.4f,%.3f,%.3f,%.3f,%.2f,%.2f,%.2f,0x%02x,%u\n",
+                   t, s.rollDeg, s.pitchDeg, s.yawDeg, m.roll, m.pitch, m.yaw,
+                   q.roll, q.pitch, q.yaw, s.acc[0], s.acc[1], s.acc[2],
+                   s.gyro[0], s.gyro[1], s.gyro[2], s.mag[0], s.mag[1], s.mag[2],
+                   mask, static_cast<unsigned>(ks));
+    }
+  }
+  if (csv) std::fclose(csv);
+
+  // Erste Sekunde (Einschwingen) auslassen, Verzögerung bis eine halbe Periode
+  size_t skip = static_cast<size_t>(rateHz);
+  long maxLag = static_cast<long>(prm.periodS * rateHz / 2);
+
+  if (!quiet) {
+    std::printf("Seegang  Kurs %.0f, Kraengung %.1f, Periode %.1f s, Roll/Pitch/Gier %.1f/%.1f/%.1f deg,"
+                " Tauchen %.2f m, Hebel %.2f m\n",
+                prm.headingDeg, prm.heelDeg, prm.periodS, prm.rollAmpDeg, prm.pitchAmpDeg,
+                prm.yawAmpDeg, prm.heaveAmpM, prm.leverM);
+    std::printf("Sensor   %.0f Hz, %zu Schritte, Rauschen %.4f g / %.2f dps / %.2f uT,"
+                " Hard-Iron %.1f,%.1f,%.1f uT\n",
+                rateHz, steps, prm.accNoiseG, prm.gyroNoiseDps, prm.magNoiseUT,
+                prm.hardIronUT[0], prm.hardIronUT[1], prm.hardIronUT[2]);
+  }
+
+  std::printf("%-12s %9s %9s %9s %10s\n", "Signal", "Bias", "RMS", "Max", "Lag ms");
+  for (const Series& s : series) {
+    ErrorStats st = analyse(s, skip, maxLag);
+    std::printf("%-12s %9.3f %9.3f %9.3f %10.1f\n", s.name, st.bias, st.rms, st.maxAbs,
+                st.lagSamples * 1000.0 / rateHz);
+  }
+
+  std::printf("Wahrheit |Roll| > 30 deg ab %.2f s, > 60 deg ab %.2f s\n", truthOver30, truthOver60);
+  for (uint8_t r = 0; r < ruleCount; ++r) {
+    std::printf("Regel %u (Kanal %u) erstmals aktiv: %.2f s\n", r,
+                static_cast<unsigned>(Alarms::getRule(r).channel), ruleFirst[r]);
+  }
+  std::printf("Knockdown ausgeloest %.2f s, bestaetigt %.2f s\n", knockLatched, knockConfirmed);
+
+  double fw = firmwareTime.count();
+  std::printf("Firmware %.3f s fuer %zu Schritte: %.0f Schritte/s\n",
+              fw, steps, fw > 0 ? steps / fw : 0.0);
+  return 0;
+}
@@ -0,0 +1,154 @@
+/*
+Rolle: Synthetischer Seegang für die IMU (PC-Simulation).
+
+Inhalt:
+
+R(t) = Rz(-Kurs) * Rx(-Pitch) * Ry(-Roll) dreht Chip- in Weltachsen
+(Ost, Nord, oben). Damit ergibt atan2(accX, accZ) im Stand genau Roll.
+
+Beschleunigung und Drehrate per zentraler Differenz von R(t) bzw. des
+Sensororts (h = 1 ms), die Bewegung bleibt so frei wählbar ohne
+eigene Ableitungen
+*/
+
+#include <cmath>
+
+#include "sea_state.h"
+
+namespace {
+
+  constexpr double G = 9.80665;
+  constexpr double DEG = M_PI / 180.0;
+  constexpr double H = 1e-3;
+
+  void rotZ(double a, double m[3][3]) {
+    double c = std::cos(a), s = std::sin(a);
+    double r[3][3] = { { c, -s, 0 }, { s, c, 0 }, { 0, 0, 1 } };
+    for (int i = 0; i < 3; ++i) for (int j = 0; j < 3; ++j) m[i][j] = r[i][j];
+  }
+
+  void rotX(double a, double m[3][3]) {
+    double c = std::cos(a), s = std::sin(a);
+    double r[3][3] = { { 1, 0, 0 }, { 0, c, -s }, { 0, s, c } };
+    for (int i = 0; i < 3; ++i) for (int j = 0; j < 3; ++j) m[i][j] = r[i][j];
+  }
+
+  void rotY(double a, double m[3][3]) {
+    double c = std::cos(a), s = std::sin(a);
+    double r[3][3] = { { c, 0, s }, { 0, 1, 0 }, { -s, 0, c } };
+    for (int i = 0; i < 3; ++i) for (int j = 0; j < 3; ++j) m[i][j] = r[i][j];
+  }
+
+  void mul(const double a[3][3], const double b[3][3], double out[3][3]) {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        out[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+      }
+    }
+  }
+
+  // R^T * v
+  void mulT(const double r[3][3], const double v[3], double out[3]) {
+    for (int i = 0; i < 3; ++i) out[i] = r[0][i] * v[0] + r[1][i] * v[1] + r[2][i] * v[2];
+  }
+
+  // Rampe 0..1..0 für den Knockdown
+  double knockWeight(double t, double start) {
+    if (start < 0 || t < start) return 0.0;
+    double x = t - start;
+    double ramp = SeaState::KNOCK_RAMP_S, hold = SeaState::KNOCK_HOLD_S;
+    if (x < ramp) return 0.5 - 0.5 * std::cos(M_PI * x / ramp);
+    if (x < ramp + hold) return 1.0;
+    if (x < 2 * ramp + hold) return 0.5 + 0.5 * std::cos(M_PI * (x - ramp - hold) / ramp);
+    return 0.0;
+  }
+
+}
+
+SeaState::SeaState(const SeaStateParams& p)
+  : prm(p),
+    omega(2.0 * M_PI / p.periodS),
+    rng(p.seed),
+    unit(0.0, 1.0) {}
+
+double SeaState::noise(double sigma) {
+  return sigma > 0 ? sigma * unit(rng) : 0.0;
+}
+
+SeaState::Attitude SeaState::truth(double t) const {
+  double w = omega * t;
+  double k = knockWeight(t, prm.knockStartS);
+  Attitude a;
+  double wave = prm.heelDeg + prm.rollAmpDeg * std::sin(w);
+  a.roll  = (1.0 - k) * wave + k * KNOCK_HEEL_DEG;
+  a.pitch = prm.pitchAmpDeg * std::sin(w + M_PI / 2);
+  a.yaw   = prm.headingDeg + prm.yawAmpDeg * std::sin(w + M_PI / 4);
+  return a;
+}
+
+void SeaState::rotation(double t, Mat r) const {
+  Attitude a = truth(t);
+  Mat z, x, y, zx;
+  rotZ(-a.yaw * DEG, z);
+  rotX(-a.pitch * DEG, x);
+  rotY(-a.roll * DEG, y);
+  mul(z, x, zx);
+  mul(zx, y, r);
+}
+
+void SeaState::position(double t, double p[3]) const {
+  Mat r;
+  rotation(t, r);
+  // Hebelarm entlang Chip-Z, dazu Tauchen
+  p[0] = r[0][2] * prm.leverM;
+  p[1] = r[1][2] * prm.leverM;
+  p[2] = r[2][2] * prm.leverM + prm.heaveAmpM * std::sin(omega * t + M_PI / 3);
+}
+
+SeaSample SeaState::at(double t) {
+  SeaSample s;
+  Attitude a = truth(t);
+  s.rollDeg = a.roll;
+  s.pitchDeg = a.pitch;
+  s.yawDeg = std::fmod(a.yaw + 360.0, 360.0);
+
+  Mat r, rp, rm;
+  rotation(t, r);
+  rotation(t + H, rp);
+  rotation(t - H, rm);
+
+  // Spezifische Kraft f = a - g, in g
+  double p0[3], pp[3], pm[3];
+  position(t, p0);
+  position(t + H, pp);
+  position(t - H, pm);
+  double fw[3];
+  for (int i = 0; i < 3; ++i) fw[i] = (pp[i] - 2 * p0[i] + pm[i]) / (H * H) / G;
+  fw[2] += 1.0;
+  double fb[3];
+  mulT(r, fw, fb);
+  for (int i = 0; i < 3; ++i) s.acc[i] = static_cast<float>(fb[i] + noise(prm.accNoiseG));
+
+  // Drehrate aus R^T * dR/dt (schiefsymmetrisch)
+  double w[3][3];
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      w[i][j] = 0.0;
+      for (int k = 0; k < 3; ++k) w[i][j] += r[k][i] * (rp[k][j] - rm[k][j]) / (2 * H);
+    }
+  }
+  double rate[3] = { w[2][1], w[0][2], w[1][0] };
+  for (int i = 0; i < 3; ++i) s.gyro[i] = static_cast<float>(rate[i] / DEG + noise(prm.gyroNoiseDps));
+
+  // Erdfeld: Nord-Komponente und nach unten geneigt
+  double inc = prm.inclinationDeg * DEG;
+  double mw[3] = { 0.0, prm.fieldUT * std::cos(inc), -prm.fieldUT * std::sin(inc) };
+  double mb[3];
+  mulT(r, mw, mb);
+  double ak[3] = { mb[1], mb[0], -mb[2] };
+  const double* out = prm.magChipAxes ? mb : ak;
+  for (int i = 0; i < 3; ++i) {
+    s.mag[i] = static_cast<float>(out[i] + prm.hardIronUT[i] + noise(prm.magNoiseUT));
+  }
+  return s;
+}
@@ -0,0 +1,80 @@
+/*
+Rolle: Synthetischer Seegang für die IMU (PC-Simulation).
+
+Inhalt:
+
+Wahre Lage aus Kurs, Krängung und einer Welle: Rollen, Stampfen, Gieren
+und Tauchen als Sinus mit fester Phasenlage zueinander, optional ein
+Knockdown (Krängung fährt auf KNOCK_HEEL_DEG und zurück)
+
+Daraus die Sensorwerte, wie MPU9250_WE sie liefert:
+  Beschleunigung in g (Chip-Achsen: X rechts, Y vorne, Z oben), inkl.
+  Tauchbeschleunigung und Hebelarm über dem Rolldrehpunkt
+  Drehrate in °/s (Chip-Achsen)
+  Magnetfeld in µT in den Achsen des AK8963 (X = Chip-Y, Y = Chip-X,
+  Z = -Chip-Z) oder wahlweise in Chip-Achsen, plus Hard-Iron-Offset
+und jeweils normalverteiltes Rauschen
+
+Vorzeichen der wahren Winkel wie MPU9250Module: Roll = atan2(accX, accZ),
+Pitch positiv = Bug hoch, Kurs rechtsweisend von Nord
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+struct SeaStateParams {
+  double headingDeg   = 0.0;
+  double heelDeg      = 0.0;     // mittlere Krängung
+  double periodS      = 6.0;     // Wellenperiode
+  double rollAmpDeg   = 15.0;
+  double pitchAmpDeg  = 5.0;
+  double yawAmpDeg    = 3.0;
+  double heaveAmpM    = 0.5;
+  double leverM       = 1.0;     // Sensor über dem Rolldrehpunkt
+
+  double accNoiseG    = 0.005;
+  double gyroNoiseDps = 0.1;
+  double magNoiseUT   = 0.5;
+  double hardIronUT[3] = { 0.0, 0.0, 0.0 };
+
+  double fieldUT      = 49.0;    // Erdfeld (Mitteleuropa)
+  double inclinationDeg = 66.0;
+  bool   magChipAxes  = false;   // true: Magnetfeld schon in Chip-Achsen (Vergleichsfall)
+
+  double knockStartS  = -1.0;    // < 0: kein Knockdown
+  uint32_t seed       = 1;
+};
+
+struct SeaSample {
+  double rollDeg, pitchDeg, yawDeg;   // Wahrheit
+  float  acc[3];                      // g
+  float  gyro[3];                     // °/s
+  float  mag[3];                      // µT
+};
+
+class SeaState {
+public:
+  explicit SeaState(const SeaStateParams& p);
+  SeaSample at(double t);
+
+  static constexpr double KNOCK_HEEL_DEG = 75.0;
+  static constexpr double KNOCK_HOLD_S   = 4.0;
+  static constexpr double KNOCK_RAMP_S   = 1.0;
+
+private:
+  struct Attitude { double roll, pitch, yaw; };
+  typedef double Mat[3][3];
+
+  Attitude truth(double t) const;
+  void rotation(double t, Mat r) const;        // Chip -> Welt (Ost, Nord, oben)
+  void position(double t, double p[3]) const;  // Sensorort in m
+
+  SeaStateParams prm;
+  double omega;
+  std::mt19937 rng;
+  std::normal_distribution<double> unit;
+
+  double noise(double sigma);
+};
@@ -0,0 +1,378 @@
+/*
+Rolle: Mitgeschnittene Sensor-Rohdaten auf dem PC durch die Firmware-Module
+schicken (Regressionstest und Benchmark).
+
+Inhalt:
+
+Liest den Replay-Strom (src/logging/replay_format.h) aus einer Logdatei
+LOGnnnnn.BIN, setzt die 10-Byte-Stücke zu Einträgen zusammen und setzt
+nach Lücken am nächsten Eintragsbeginn + Clock-Eintrag wieder auf
+
+Abspielen in derselben Reihenfolge wie auf dem Gerät:
+  Env   -> BME280Sensor::update(), DataStore::publishEnv()/Tendenz
+  Imu   -> MPU9250Module::update(), DataStore::publishIMU()
+  Knock -> Knockdown::checkSample() (auf dem Gerät im Data-Ready-ISR)
+  Loop  -> MenuSystem::update(), Knockdown::update(), Alarms::update()
+
+Nach jeder Loop-Marke geht der sichtbare Zustand (alle DataStore-Kanäle,
+aktive Alarmregeln, Knockdown, Buzzer, Screen) in eine FNV-1a-Prüfsumme.
+Gleiche Aufnahme + gleicher Code = gleiche Prüfsumme; -e vergleicht mit
+einem erwarteten Wert. Mit -n N wird N-mal abgespielt und gemessen.
+*/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "log_reader.h"
+#include "replay_format.h"
+
+#include "alarms.h"
+#include "bme280_sensor.h"
+#include "buttons.h"
+#include "data_store.h"
+#include "host_board.h"
+#include "knockdown.h"
+#include "menu_system.h"
+#include "mpu9250_sensor.h"
+
+namespace {
+
+  struct Entry {
+    uint32_t  ms;
+    ReplayTag tag;
+    union {
+      float    f[6];
+      int16_t  s[2];
+      uint32_t u[2];
+      uint8_t  b[2];
+    };
+  };
+
+  struct DecodeStats {
+    uint64_t chunks = 0;
+    uint64_t bytes = 0;
+    uint64_t resyncs = 0;
+    uint64_t skipped = 0;        // Einträge vor dem ersten Clock nach einer Lücke
+    uint64_t perTag[8] = {};
+  };
+
+  void usage(const char* prog) {
+    std::fprintf(stderr, "usage: %s [-n repeats] [-e digest] [-t trace.csv] [-q] LOGnnnnn.BIN\n", prog);
+  }
+
+  // Stücke -> Einträge. pending hält die Bytes eines angefangenen Eintrags.
+  class Decoder {
+  public:
+    explicit Decoder(std::vector<Entry>& out) : entries(out) {}
+
+    void lose() {
+      if (synced) stats.resyncs++;
+      synced = false;
+      pending.clear();
+    }
+
+    void chunk(const LogRecord& r) {
+      uint8_t count = replayChunkCount(r.flags);
+      uint8_t first = replayChunkFirstEntry(r.flags);
+      if (count == 0 || count > REPLAY_CHUNK_BYTES) { lose(); return; }
+      stats.chunks++;
+      stats.bytes += count;
+
+      uint8_t from = 0;
+      if (!synced) {
+        if (first >= count) return;
+        from = first;
+        synced = true;
+        haveTime = false;
+      }
+      pending.insert(pending.end(), r.bytes + from, r.bytes + count);
+      parse();
+    }
+
+    DecodeStats stats;
+
+  private:
+    std::vector<Entry>& entries;
+    std::vector<uint8_t> pending;
+    bool synced = false;
+    bool haveTime = false;       // nach einem Wiederaufsetzen erst ab dem nächsten Clock
+    uint32_t lastMs = 0;
+
+    void parse() {
+      size_t pos = 0;
+      while (pending.size() - pos >= 2) {
+        uint8_t tag = pending[pos];
+        int8_t size = replayPayloadSize(tag);
+        if (size < 0) { lose(); return; }
+        bool absolute = pending[pos + 1] == REPLAY_DT_ABSOLUTE;
+        size_t need = 2 + (absolute ? 4 : 0) + size;
+        if (pending.size() - pos < need) break;
+
+        const uint8_t* p = pending.data() + pos;
+        Entry e;
+        std::memset(&e, 0, sizeof(e));
+        e.tag = static_cast<ReplayTag>(tag);
+        if (absolute) {
+          std::memcpy(&e.ms, p + 2, 4);
+        } else {
+          e.ms = lastMs + p[1];
+        }
+        std::memcpy(e.f, p + need - size, size);
+        if (e.tag == ReplayTag::Clock) {
+          e.ms = e.u[1];
+          haveTime = true;
+        } else if (absolute) {
+          haveTime = true;
+        }
+        lastMs = e.ms;
+        pos += need;
+
+        if (!haveTime) {
+          stats.skipped++;
+          continue;
+        }
+        stats.perTag[tag]++;
+        entries.push_back(e);
+      }
+      pending.erase(pending.begin(), pending.begin() + pos);
+    }
+  };
+
+  struct Snapshot {
+    int16_t  channel[static_cast<uint8_t>(Channel::COUNT)];
+    uint8_t  alarmMask;
+    uint8_t  knockdown;
+    uint8_t  buzzer;
+    uint8_t  screen;
+    uint8_t  editing;
+
+    bool operator!=(const Snapshot& o) const {
+      return std::memcmp(this, &o, sizeof(*this)) != 0;
+    }
+  };
+
+  Snapshot capture() {
+    Snapshot s;
+    std::memset(&s, 0, sizeof(s));
+    for (uint8_t c = 0; c < static_cast<uint8_t>(Channel::COUNT); ++c) {
+      s.channel[c] = DataStore::getRaw(static_cast<Channel>(c));
+    }
+    for (uint8_t i = 0; i < Alarms::getRuleCount() && i < 8; ++i) {
+      if (Alarms::isActive(i)) s.alarmMask |= (uint8_t)(1 << i);
+    }
+    s.knockdown = static_cast<uint8_t>(Knockdown::getState());
+    s.buzzer = HostBoard::buzzerPattern();
+    s.screen = static_cast<uint8_t>(MenuSystem::getCurrentScreen());
+    s.editing = MenuSystem::isEditing();
+    return s;
+  }
+
+  uint64_t fnv1a(uint64_t h, const void* data, size_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (len--) {
+      h ^= *p++;
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+  void traceHeader(FILE* f) {
+    std::fprintf(f, "ms,utc,temp_c,hum_pct,press_hpa,roll_deg,pitch_deg,yaw_deg,"
+                    "bat_v,bat_pct,trend_hpa3h,alarms,knockdown,buzzer,screen,editing\n");
+  }
+
+  void traceRow(FILE* f, uint32_t ms, uint32_t utc, const Snapshot& s) {
+    std::fprintf(f, "%" PRIu32 ",%" PRIu32, ms, utc);
+    for (uint8_t c = 0; c < static_cast<uint8_t>(Channel::COUNT); ++c) {
+      std::fprintf(f, ",%g", DataStore::rawToValue(static_cast<Channel>(c), s.channel[c]));
+    }
+    std::fprintf(f, ",0x%02x,%u,%d,%u,%u\n", s.alarmMask, s.knockdown,
+                 s.buzzer == 0xFF ? -1 : s.buzzer, s.screen, s.editing);
+  }
+
+  struct RunResult {
+    uint64_t digest = 14695981039346656037ULL;
+    uint64_t loops = 0;
+    uint32_t buzzerStarts = 0;
+  };
+
+  // Wie systemInit(): nur die Module, die der Strom antreibt
+  void bootModules() {
+    HostBoard::reset();
+    Buttons::begin();
+    Buzzer::begin();
+    MPU9250Module::begin();
+    BME280Sensor::begin();
+    DataStore::begin();
+    Alarms::begin();
+    MenuSystem::begin();
+  }
+
+  RunResult run(const std::vector<Entry>& entries, FILE* trace) {
+    RunResult res;
+    bootModules();
+
+    Snapshot last;
+    std::memset(&last, 0xFF, sizeof(last));
+    uint32_t clockEpoch = 0, clockMs = 0;
+
+    for (const Entry& e : entries) {
+      HostBoard::setMillis(e.ms);
+      switch (e.tag) {
+        case ReplayTag::Env:
+          HostBoard::setEnv(e.f);
+          BME280Sensor::update();
+          DataStore::publishEnv(BME280Sensor::getEnvData());
+          if (BME280Sensor::hasPressureTrend()) {
+            DataStore::publishPressureTrend(BME280Sensor::getPressureTrend());
+          }
+          break;
+
+        case ReplayTag::Imu:
+          HostBoard::setImu(e.f);
+          MPU9250Module::update();
+          DataStore::publishIMU(MPU9250Module::getIMU());
+          break;
+
+        case ReplayTag::Knock:
+          Knockdown::checkSample(e.s[0], e.s[1]);
+          break;
+
+        case ReplayTag::Clock:
+          clockEpoch = e.u[0];
+          clockMs = e.ms;
+          break;
+
+        case ReplayTag::Button:
+          HostBoard::pushButton(e.b[0], e.b[1]);
+          break;
+
+        case ReplayTag::Loop: {
+          MenuSystem::update();
+          Knockdown::update();
+          Alarms::update();
+
+          Snapshot s = capture();
+          res.digest = fnv1a(res.digest, &s, sizeof(s));
+          res.loops++;
+          if (trace && s != last) {
+            uint32_t utc = clockEpoch ? clockEpoch + (e.ms - clockMs) / 1000 : 0;
+            traceRow(trace, e.ms, utc, s);
+          }
+          last = s;
+          break;
+        }
+      }
+    }
+    res.buzzerStarts = HostBoard::buzzerStarts();
+    return res;
+  }
+
+}
+
+int main(int argc, char** argv) {
+  long repeats = 1;
+  const char* expect = nullptr;
+  const char* tracePath = nullptr;
+  bool quiet = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:e:t:q")) != -1) {
+    switch (opt) {
+      case 'n': repeats = std::strtol(optarg, nullptr, 10); break;
+      case 'e': expect = optarg; break;
+      case 't': tracePath = optarg; break;
+      case 'q': quiet = true; break;
+      default: usage(argv[0]); return 2;
+    }
+  }
+  if (optind != argc - 1 || repeats < 1) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  MappedFile file(argv[optind]);
+  if (!file.ok()) {
+    std::fprintf(stderr, "%s: kann nicht gelesen werden\n", argv[optind]);
+    return 2;
+  }
+
+  // Einmal dekodieren, gemessen wird nur das Abspielen
+  std::vector<Entry> entries;
+  Decoder dec(entries);
+  uint32_t expectSeq = 0;
+  BlockStats bs = forEachBlock(file, [&](const LogBlock& b) {
+    if (b.header.seq != expectSeq || b.header.dropped > 0) dec.lose();
+    expectSeq = b.header.seq + 1;
+    for (uint8_t i = 0; i < b.header.count; ++i) {
+      if (b.records[i].type == static_cast<uint8_t>(LogType::Replay)) dec.chunk(b.records[i]);
+    }
+  });
+
+  if (entries.empty()) {
+    std::fprintf(stderr, "%s: kein Replay-Strom (mit RECORD_INPUTS 1 aufgezeichnet?)\n", argv[optind]);
+    return 2;
+  }
+
+  FILE* trace = nullptr;
+  if (tracePath) {
+    trace = std::fopen(tracePath, "w");
+    if (!trace) {
+      std::fprintf(stderr, "%s: kann nicht geschrieben werden\n", tracePath);
+      return 2;
+    }
+    traceHeader(trace);
+  }
+
+  RunResult first = run(entries, trace);
+  if (trace) std::fclose(trace);
+
+  bool deterministic = true;
+  auto t0 = std::chrono::steady_clock::now();
+  for (long i = 1; i < repeats; ++i) {
+    if (run(entries, nullptr).digest != first.digest) deterministic = false;
+  }
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  const DecodeStats& ds = dec.stats;
+  char digest[17];
+  std::snprintf(digest, sizeof(digest), "%016" PRIx64, first.digest);
+
+  if (!quiet) {
+    double span = (entries.back().ms - entries.front().ms) / 1000.0;
+    std::printf("Bloecke  %" PRIu64 " (CRC-Fehler %" PRIu64 ", Luecken %" PRIu64 ", verworfen %" PRIu64 ")\n",
+                bs.blocks, bs.crcErrors, bs.seqGaps, bs.dropped);
+    std::printf("Strom    %" PRIu64 " Bytes, %zu Eintraege, %" PRIu64 " mal neu aufgesetzt, %" PRIu64 " uebersprungen\n",
+                ds.bytes, entries.size(), ds.resyncs, ds.skipped);
+    std::printf("Eintraege imu %" PRIu64 ", knock %" PRIu64 ", env %" PRIu64 ", clock %" PRIu64
+                ", button %" PRIu64 ", loop %" PRIu64 "\n",
+                ds.perTag[3], ds.perTag[4], ds.perTag[5], ds.perTag[2], ds.perTag[6], ds.perTag[1]);
+    std::printf("Dauer    %.1f s Aufnahme, %" PRIu64 " loop()-Runden, %" PRIu32 " Buzzer-Starts\n",
+                span, first.loops, first.buzzerStarts);
+  }
+  std::printf("digest   %s\n", digest);
+
+  if (repeats > 1) {
+    double loops = static_cast<double>(first.loops) * (repeats - 1);
+    double ents = static_cast<double>(entries.size()) * (repeats - 1);
+    std::printf("bench    %ld Durchlaeufe in %.3f s: %.0f Runden/s, %.0f Eintraege/s\n",
+                repeats - 1, secs, secs > 0 ? loops / secs : 0.0, secs > 0 ? ents / secs : 0.0);
+    if (!deterministic) {
+      std::fprintf(stderr, "Durchlaeufe liefern verschiedene Pruefsummen\n");
+      return 1;
+    }
+  }
+
+  if (expect && std::strcmp(expect, digest) != 0) {
+    std::fprintf(stderr, "Pruefsumme %s, erwartet %s\n", digest, expect);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,15 @@
+/*
+Rolle: Adafruit_BME280-Ersatz. Liefert die Werte des zuletzt abgespielten
+Env-Eintrags (Druck in Pa wie die Library).
+*/
+
+#pragma once
+#include <Arduino.h>
+
+class Adafruit_BME280 {
+public:
+  bool begin(uint8_t = 0x77) { return true; }
+  float readTemperature() { return HostBoard::env()[0]; }
+  float readHumidity()    { return HostBoard::env()[1]; }
+  float readPressure()    { return HostBoard::env()[2]; }
+};
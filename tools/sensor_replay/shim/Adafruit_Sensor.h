@@ -0,0 +1,5 @@
+/*
+Rolle: Platzhalter für Adafruit_Sensor (wird nur eingebunden).
+*/
+
+#pragma once
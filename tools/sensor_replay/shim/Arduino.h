@@ -0,0 +1,53 @@
+/*
+Rolle: Arduino-Ersatz für das Abspielen der Firmware-Module auf dem PC.
+
+Inhalt:
+
+Nur was data_store, alarms, knockdown, i2c_bus, menu_system und die
+Sensor-Module brauchen. millis() liefert die Zeit des gerade abgespielten
+Eintrags (host_board.cpp), Interrupts und Pins sind leere Funktionen.
+*/
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_board.h"
+
+typedef uint8_t byte;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+#define FALLING      2
+#define RISING       3
+#define A0           54
+#define A8           62
+#define A9           63
+
+#define PROGMEM
+#define F(s) (s)
+#define memcpy_P memcpy
+
+inline unsigned long millis() { return HostBoard::millis(); }
+inline void delay(unsigned long) {}
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline int  digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+
+// Arduino hat min/max als Makros; hier als Funktionen, damit <algorithm> heil bleibt
+template <typename A, typename B>
+inline auto min(A a, B b) -> decltype(true ? A() : B()) { return a < b ? a : b; }
+template <typename A, typename B>
+inline auto max(A a, B b) -> decltype(true ? A() : B()) { return a > b ? a : b; }
@@ -0,0 +1,27 @@
+/*
+Rolle: EEPROM-Ersatz (4 KB wie der Mega 2560, startet gelöscht mit 0xFF).
+*/
+
+#pragma once
+#include <Arduino.h>
+
+struct EEPROMClass {
+  uint8_t mem[4096];
+
+  template <typename T> T& get(int addr, T& t) {
+    memcpy(&t, mem + addr, sizeof(T));
+    return t;
+  }
+  template <typename T> const T& put(int addr, const T& t) {
+    memcpy(mem + addr, &t, sizeof(T));
+    return t;
+  }
+  uint8_t read(int addr) { return mem[addr]; }
+  void write(int addr, uint8_t v) { mem[addr] = v; }
+  void update(int addr, uint8_t v) { mem[addr] = v; }
+  uint16_t length() { return sizeof(mem); }
+};
+
+extern EEPROMClass EEPROM;
+
+inline int eeprom_is_ready() { return 1; }
@@ -0,0 +1,55 @@
+/*
+Rolle: MPU9250_WE-Ersatz. getGValues()/getMagValues() liefern die Werte
+des zuletzt abgespielten Imu-Eintrags (sensor_replay) bzw. des Seegang-
+Generators (sea_sim, dort auch getGyrValues()), alles andere tut nichts
+(Offsets bleiben 0).
+*/
+
+#pragma once
+#include <Arduino.h>
+
+struct xyzFloat {
+  float x, y, z;
+};
+
+enum {
+  MPU9250_ACC_RANGE_8G, MPU9250_GYRO_RANGE_500, AK8963_CONT_MODE_100HZ,
+  MPU9250_DLPF_3, MPU9250_ACT_HIGH, MPU9250_DATA_READY
+};
+
+class MPU9250_WE {
+public:
+  explicit MPU9250_WE(uint8_t) {}
+  bool init() { return true; }
+  bool initMagnetometer() { return true; }
+  void setAccRange(int) {}
+  void setGyrRange(int) {}
+  void setMagOpMode(int) {}
+  void autoOffsets() {}
+  xyzFloat getAccOffsets() { return { 0, 0, 0 }; }
+  xyzFloat getGyrOffsets() { return { 0, 0, 0 }; }
+  void setAccOffsets(xyzFloat) {}
+  void setGyrOffsets(xyzFloat) {}
+  void enableAccDLPF(bool) {}
+  void setAccDLPF(int) {}
+  void enableGyrDLPF() {}
+  void setGyrDLPF(int) {}
+  void setSampleRateDivider(uint8_t) {}
+  void setIntPinPolarity(int) {}
+  void enableIntLatch(bool) {}
+  void enableClearIntByAnyRead(bool) {}
+  void enableInterrupt(int) {}
+
+  xyzFloat getGValues() {
+    const float* v = HostBoard::imu();
+    return { v[0], v[1], v[2] };
+  }
+  xyzFloat getMagValues() {
+    const float* v = HostBoard::imu();
+    return { v[3], v[4], v[5] };
+  }
+  xyzFloat getGyrValues() {
+    const float* v = HostBoard::gyro();
+    return { v[0], v[1], v[2] };
+  }
+};
@@ -0,0 +1,18 @@
+/*
+Rolle: Wire-Ersatz. Es gibt keinen Bus, jede Übertragung schlägt fehl;
+die Module holen ihre Werte über die Sensor-Ersatzklassen.
+*/
+
+#pragma once
+#include <Arduino.h>
+
+struct TwoWire {
+  void begin() {}
+  void beginTransmission(uint8_t) {}
+  size_t write(uint8_t) { return 1; }
+  uint8_t endTransmission(bool = true) { return 2; }
+  uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+  int read() { return -1; }
+};
+
+extern TwoWire Wire;